@@ -59,7 +59,7 @@ int main(){
 #endif             // sample code
 
 
-namespace mkn::avx
+namespace mkn::avx::inline MKN_AVX_TIER
 {
 template<std::size_t N, typename Data>
 auto inline make_span(Data* data, auto const start = 0) noexcept
@@ -0,0 +1,264 @@
+/**
+Copyright (c) 2024, Philip Deegan.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+    * Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the following disclaimer
+in the documentation and/or other materials provided with the
+distribution.
+    * Neither the name of Philip Deegan nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef _MKN_AVX_ARENA_HPP_
+#define _MKN_AVX_ARENA_HPP_
+
+#include "mkn/avx/def.hpp"
+
+#include <new>
+#include <vector>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+
+// Bump allocation for short lived buffers, released all at once
+//
+//   mkn::avx::Arena arena;
+//   auto [l0, l1, l2] = mkn::avx::lazy(arena, a0, a1, a2);
+//   for (std::size_t step = 0; step < steps; ++step)
+//   {
+//       mkn::avx::Arena::Scope scope{arena};
+//       mkn::avx::Vector<double, mkn::avx::ArenaAllocator<double>> tmp(size);
+//       auto r = mkn::avx::eval(l0 * l1 + l2, arena);
+//   } // tmp and r are returned to the arena, nothing is freed
+//
+// An arena serves one thread, give each thread its own. While a Scope is
+// alive on a thread, default constructed ArenaAllocators made there draw from
+// its arena, otherwise they use the heap. Lazy expression graphs use the heap
+// unless their vectors were given an arena - mkn::avx::lazy(arena, a0, a1).
+// Nothing from an arena may be used, or destroyed, after its scope ends.
+
+namespace mkn::avx::inline MKN_AVX_TIER
+{
+
+class Arena
+{
+    struct Chunk
+    {
+        std::byte* ptr;
+        std::size_t size;
+    };
+
+public:
+    // of every chunk, the most allocate aligns to
+    std::size_t static constexpr ALIGN = 64;
+
+    struct Mark
+    {
+        std::size_t chunk = 0, used = 0;
+    };
+
+    // the thread's arena from construction until destruction, when everything
+    // allocated since is released - the previous scope is restored
+    class Scope
+    {
+    public:
+        Scope(Arena& _arena)
+            : arena{_arena}
+            , mark{_arena.mark()}
+            , prev{current_}
+        {
+            current_ = &arena;
+        }
+        ~Scope()
+        {
+            current_ = prev;
+            arena.rewind(mark);
+        }
+
+        Scope(Scope const&)            = delete;
+        Scope& operator=(Scope const&) = delete;
+
+    private:
+        Arena& arena;
+        Mark const mark;
+        Arena* const prev;
+    };
+
+    explicit Arena(std::size_t const _chunk_bytes = std::size_t{1} << 20)
+        : chunk_bytes{_chunk_bytes}
+    {
+    }
+    ~Arena()
+    {
+        for (auto const& chunk : chunks)
+            ::operator delete(chunk.ptr, std::align_val_t{ALIGN});
+    }
+
+    Arena(Arena const&)            = delete;
+    Arena& operator=(Arena const&) = delete;
+
+    // bytes aligned to align, a power of two up to ALIGN
+    void* allocate(std::size_t const bytes, std::size_t const align = Options::ALIGN())
+    {
+        assert(align and align <= ALIGN and (align & (align - 1)) == 0);
+
+        std::size_t off = round_up(used, align);
+        while (at < chunks.size() and off + bytes > chunks[at].size)
+            off = 0, ++at;
+        if (at == chunks.size())
+            chunks.emplace_back(make_chunk(std::max(chunk_bytes, round_up(bytes, ALIGN))));
+        used = off + bytes;
+        return chunks[at].ptr + off;
+    }
+
+    Mark mark() const { return {at, used}; }
+
+    // everything allocated after m is released, its memory kept
+    void rewind(Mark const& m)
+    {
+        at = m.chunk, used = m.used;
+        if (at == 0 and used == 0)
+            merge();
+    }
+
+    void release() { rewind({}); }
+
+    // bytes held, in use or not
+    std::size_t capacity() const
+    {
+        std::size_t size = 0;
+        for (auto const& chunk : chunks)
+            size += chunk.size;
+        return size;
+    }
+
+    std::size_t chunk_count() const { return chunks.size(); }
+
+    // the arena of the innermost Scope on this thread, or nullptr
+    static Arena* current() { return current_; }
+
+private:
+    // one chunk of the total held, so a step that needed several chunks fits
+    // the next time in one. it is allocated before anything is freed, and if
+    // that fails the chunks are kept as they are - rewind runs in ~Scope
+    void merge() noexcept
+    {
+        if (chunks.size() < 2)
+            return;
+        std::size_t const size = capacity();
+        auto* const ptr        = ::operator new(size, std::align_val_t{ALIGN}, std::nothrow);
+        if (!ptr)
+            return;
+        for (auto const& c : chunks)
+            ::operator delete(c.ptr, std::align_val_t{ALIGN});
+        chunks.erase(chunks.begin() + 1, chunks.end()); // no element constructed
+        chunks.front() = {static_cast<std::byte*>(ptr), size};
+    }
+
+    std::size_t static round_up(std::size_t const bytes, std::size_t const align)
+    {
+        return (bytes + align - 1) & ~(align - 1);
+    }
+
+    static Chunk make_chunk(std::size_t const size)
+    {
+        return {static_cast<std::byte*>(::operator new(size, std::align_val_t{ALIGN})), size};
+    }
+
+    std::size_t const chunk_bytes;
+    std::vector<Chunk> chunks;
+    std::size_t at = 0, used = 0; // chunk being bumped and bytes used of it
+
+    static inline thread_local Arena* current_ = nullptr;
+};
+
+// std allocator over an Arena, deallocate is a no-op. Default constructed it
+// takes Arena::current(), with none it allocates and frees on the heap
+//   mkn::avx::Vector<float, mkn::avx::ArenaAllocator<float>> v(size);
+template<typename T, std::size_t A = Options::ALIGN()>
+class ArenaAllocator
+{
+    std::size_t static constexpr align = std::max(A, alignof(T));
+
+public:
+    using value_type = T;
+    template<typename U>
+    struct rebind
+    {
+        using other = ArenaAllocator<U, A>;
+    };
+
+    constexpr ArenaAllocator() noexcept
+        : arena{std::is_constant_evaluated() ? nullptr : Arena::current()}
+    {
+    }
+    constexpr ArenaAllocator(Arena& _arena) noexcept
+        : arena{&_arena}
+    {
+    }
+    constexpr explicit ArenaAllocator(Arena* const _arena) noexcept
+        : arena{_arena}
+    {
+    }
+    template<typename U>
+    constexpr ArenaAllocator(ArenaAllocator<U, A> const& that) noexcept
+        : arena{that.arena}
+    {
+    }
+
+    T* allocate(std::size_t const n)
+    {
+        if (arena)
+            return static_cast<T*>(arena->allocate(n * sizeof(T), align));
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{align}));
+    }
+    void deallocate(T* const p, std::size_t const) noexcept
+    {
+        if (!arena)
+            ::operator delete(p, std::align_val_t{align});
+    }
+
+    template<typename U>
+    bool operator==(ArenaAllocator<U, A> const& that) const
+    {
+        return arena == that.arena;
+    }
+    template<typename U>
+    bool operator!=(ArenaAllocator<U, A> const& that) const
+    {
+        return arena != that.arena;
+    }
+
+    Arena* arena; // nullptr for the heap
+};
+
+template<typename T, std::size_t A>
+bool constexpr is_aligned(std::vector<T, ArenaAllocator<T, A>> const&)
+{
+    return A >= Options::ALIGN();
+}
+
+} // namespace mkn::avx
+
+#endif /* _MKN_AVX_ARENA_HPP_ */
@@ -40,7 +40,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <optional>
 
 
-namespace mkn::avx::detail
+namespace mkn::avx::inline MKN_AVX_TIER::detail
 {
 template<typename T, std::size_t N, std::size_t A = Options::ALIGN()>
 struct _A_
@@ -53,7 +53,7 @@ struct _A_
 } // namespace mkn::avx::detail
 
 
-namespace mkn::avx
+namespace mkn::avx::inline MKN_AVX_TIER
 {
 
 template<typename T, std::size_t N>
@@ -69,22 +69,63 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #endif
 
 
+// msvc has no __FMA__, /arch:AVX2 implies it
+#if (defined(__FMA__) || (defined(_MSC_VER) && defined(__AVX2__))) && !defined(MKN_AVX_FMA_ACTIVE)
+#define MKN_AVX_FMA_ACTIVE 1
+#endif
+
+#if !defined(MKN_AVX_FMA_ACTIVE)
+#define MKN_AVX_FMA_ACTIVE 0
+#endif
+
+
+// everything but Exception and the dispatch table is declared in an inline namespace
+//   named for the widest instruction set enabled, mkn::avx::Span<double> is
+//   mkn::avx::isa_avx2::Span<double> under -mavx2. translation units built with
+//   different -m flags then share no inline template, see dispatch.hpp
+#if !defined(MKN_AVX_TIER)
+#if MKN_AVX_512_ACTIVE
+#define MKN_AVX_TIER isa_avx512
+#elif MKN_AVX_2_ACTIVE
+#define MKN_AVX_TIER isa_avx2
+#elif MKN_AVX_1_ACTIVE
+#define MKN_AVX_TIER isa_avx
+#else
+#define MKN_AVX_TIER isa_none
+#endif
+#endif
+
+// for what is shared between tiers, built for baseline x86-64 whatever the -m
+//   flags, so the copy the linker keeps runs anywhere
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define MKN_AVX_BASELINE __attribute__((target("arch=x86-64")))
+#else
+#define MKN_AVX_BASELINE
+#endif
+
+
 namespace mkn::avx
 {
 class Exception : public kul::Exception
 {
 public:
-    Exception(char const* f, uint16_t const& l, std::string const& s)
+    MKN_AVX_BASELINE Exception(char const* f, uint16_t const& l, std::string const& s)
         : kul::Exception(f, l, s)
     {
     }
 };
 
+} /* namespace mkn::avx */
+
+namespace mkn::avx::inline MKN_AVX_TIER
+{
+
 struct Options
 {
     bool static constexpr AVX    = MKN_AVX_1_ACTIVE;
     bool static constexpr AVX2   = MKN_AVX_2_ACTIVE;
     bool static constexpr AVX512 = MKN_AVX_512_ACTIVE;
+    bool static constexpr FMA    = MKN_AVX_FMA_ACTIVE;
 
     template<typename AT>
     std::uint16_t static constexpr N()
@@ -119,6 +160,17 @@ struct Options
         else
             return 8;
     }
+
+    // Span writes of at least this many bytes use non-temporal stores under
+    // Store::AUTO, see span.hpp - past the last level cache of most parts
+    std::size_t static constexpr STREAM_BYTES()
+    {
+#if defined(MKN_AVX_STREAM_BYTES)
+        return MKN_AVX_STREAM_BYTES;
+#endif
+
+        return std::size_t{64} << 20;
+    }
 };
 
 template<typename T, std::uint16_t N>
@@ -0,0 +1,288 @@
+/**
+Copyright (c) 2024, Philip Deegan.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+    * Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the following disclaimer
+in the documentation and/or other materials provided with the
+distribution.
+    * Neither the name of Philip Deegan nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef _MKN_AVX_DISPATCH_HPP_
+#define _MKN_AVX_DISPATCH_HPP_
+
+#include "mkn/avx/def.hpp"
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+
+// Runtime ISA selection
+//
+// Options::N/ALIGN are fixed per translation unit by the -m flags it is built
+// with. To ship one binary for mixed fleets, compile the same kernel source
+// once per tier (e.g. -mavx, -mavx2 -mfma, -march=x86-64-v4) and register each
+// build into a shared Dispatch table, the widest one the running cpu supports
+// is used.
+//
+//   // kernels.hpp
+//   inline constinit mkn::avx::Dispatch<void(double*, double const*, std::size_t)> add_to{};
+//
+//   // kernels.ipp - included by kernels_avx2.cpp, kernels_avx512.cpp, ...
+//   namespace {
+//   void add_to_impl(double* a, double const* b, std::size_t size) {
+//       mkn::avx::AsymmetricSpan<double, mkn::avx::Options::N<double>()> sa{a, size};
+//       ... }
+//   }
+//   MKN_AVX_DISPATCH_REGISTER(add_to, add_to_impl);
+//
+//   // anywhere
+//   add_to(a.data(), b.data(), a.size());
+//
+// The library is declared in a namespace per tier (see MKN_AVX_TIER), so the
+// inline templates each tier instantiates are distinct symbols and the linker
+// cannot keep the -mavx2 build of one and call it from the scalar tier. That
+// does not extend to templates outside mkn::avx instantiated on builtin types
+// only, e.g. std::sort<double*>, keep those out of kernel sources or wrap them.
+// Kernels themselves should live in an anonymous namespace. What is shared, this
+// header and Exception, is built for baseline x86-64, see MKN_AVX_BASELINE.
+// Build each tier once, and allocate containers passed between tiers with the
+// widest alignment, see MKN_AVX_ALIGN_AS.
+//
+// The environment variable MKN_AVX_ISA=none|avx|avx2|avx512 caps the detected
+// tier, which is useful for testing narrower kernels on wide hardware.
+
+namespace mkn::avx
+{
+// tiers follow Options::N - AVX is the 128 bit tier
+enum class ISA : std::uint8_t { NONE = 0, AVX, AVX2, AVX512 };
+
+MKN_AVX_BASELINE std::uint16_t constexpr bits(ISA const isa) noexcept
+{
+    return isa == ISA::AVX512 ? 512 : isa == ISA::AVX2 ? 256 : isa == ISA::AVX ? 128 : 0;
+}
+
+// lanes of T per register for a tier, 1 when scalar
+template<typename T>
+MKN_AVX_BASELINE std::uint16_t constexpr lanes(ISA const isa) noexcept
+{
+    return isa == ISA::NONE ? 1 : bits(isa) / 8 / sizeof(T);
+}
+
+MKN_AVX_BASELINE inline std::string to_string(ISA const isa)
+{
+    switch (isa)
+    {
+        case ISA::AVX512: return "avx512";
+        case ISA::AVX2: return "avx2";
+        case ISA::AVX: return "avx";
+        default: return "none";
+    }
+}
+
+namespace cpu
+{
+    struct CPUID
+    {
+        std::uint32_t eax = 0, ebx = 0, ecx = 0, edx = 0;
+    };
+
+    MKN_AVX_BASELINE inline CPUID cpuid(std::uint32_t const leaf,
+                                        std::uint32_t const sub = 0) noexcept
+    {
+        CPUID id;
+#if defined(_MSC_VER)
+        int r[4];
+        __cpuidex(r, static_cast<int>(leaf), static_cast<int>(sub));
+        id = {static_cast<std::uint32_t>(r[0]), static_cast<std::uint32_t>(r[1]),
+              static_cast<std::uint32_t>(r[2]), static_cast<std::uint32_t>(r[3])};
+#else
+        if (leaf <= __get_cpuid_max(0, nullptr))
+            __cpuid_count(leaf, sub, id.eax, id.ebx, id.ecx, id.edx);
+#endif
+        return id;
+    }
+
+    // register state the OS saves on context switch
+    MKN_AVX_BASELINE inline std::uint64_t xcr0() noexcept
+    {
+#if defined(_MSC_VER)
+        return _xgetbv(0);
+#else
+        std::uint32_t eax = 0, edx = 0;
+        __asm__ __volatile__("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+        return (static_cast<std::uint64_t>(edx) << 32) | eax;
+#endif
+    }
+
+    MKN_AVX_BASELINE inline bool bit(std::uint32_t const reg, std::uint8_t const b) noexcept
+    {
+        return (reg >> b) & 1;
+    }
+
+    MKN_AVX_BASELINE inline ISA parse_isa(char const* const s) noexcept
+    {
+        if (std::strcmp(s, "avx512") == 0)
+            return ISA::AVX512;
+        if (std::strcmp(s, "avx2") == 0)
+            return ISA::AVX2;
+        if (std::strcmp(s, "avx") == 0)
+            return ISA::AVX;
+        return ISA::NONE;
+    }
+
+} // namespace cpu
+
+// widest tier the running cpu and OS support
+//  AVX    : avx
+//  AVX2   : avx2 + fma
+//  AVX512 : avx512 f/cd/bw/dq/vl (x86-64-v4) + OS zmm state
+MKN_AVX_BASELINE inline ISA detect_isa() noexcept
+{
+    using namespace cpu;
+
+    auto const l1 = cpuid(1);
+    if (!bit(l1.ecx, 27) or !bit(l1.ecx, 28)) // osxsave, avx
+        return ISA::NONE;
+
+    auto const xcr = xcr0();
+    if ((xcr & 0x6) != 0x6) // xmm/ymm state
+        return ISA::NONE;
+
+    auto const l7 = cpuid(7);
+    if (!bit(l7.ebx, 5) or !bit(l1.ecx, 12)) // avx2, fma
+        return ISA::AVX;
+
+    bool const avx512 = bit(l7.ebx, 16) and bit(l7.ebx, 17) and bit(l7.ebx, 28)
+                        and bit(l7.ebx, 30) and bit(l7.ebx, 31); // f, dq, cd, bw, vl
+    if (!avx512 or (xcr & 0xE6) != 0xE6)                         // opmask/zmm state
+        return ISA::AVX2;
+
+    return ISA::AVX512;
+}
+
+// detected once, capped by MKN_AVX_ISA if set
+MKN_AVX_BASELINE inline ISA isa() noexcept
+{
+    static ISA const v = [] {
+        auto const detected = detect_isa();
+        if (auto const* env = std::getenv("MKN_AVX_ISA"))
+        {
+            auto const cap = cpu::parse_isa(env);
+            return cap < detected ? cap : detected;
+        }
+        return detected;
+    }();
+    return v;
+}
+
+
+template<typename Fn>
+class Dispatch
+{
+    auto constexpr static TIERS = static_cast<std::size_t>(ISA::AVX512) + 1;
+
+public:
+    constexpr Dispatch() noexcept = default;
+
+    MKN_AVX_BASELINE Dispatch& set(ISA const tier, Fn* const fn) noexcept
+    {
+        fns[static_cast<std::size_t>(tier)] = fn;
+        best.store(nullptr);
+        return *this;
+    }
+
+    // widest registered tier <= isa()
+    MKN_AVX_BASELINE ISA selected() const
+    {
+        for (auto i = static_cast<std::size_t>(isa()) + 1; i-- > 0;)
+            if (fns[i])
+                return static_cast<ISA>(i);
+        KEXCEPT(Exception, "mkn::avx::Dispatch: no kernel registered for " + to_string(isa())
+                               + " or below");
+    }
+
+    MKN_AVX_BASELINE Fn* get() const
+    {
+        if (auto* fn = best.load(std::memory_order_relaxed))
+            return fn;
+        auto* fn = fns[static_cast<std::size_t>(selected())];
+        best.store(fn, std::memory_order_relaxed);
+        return fn;
+    }
+
+    // the kernel registered for exactly this tier, or nullptr
+    MKN_AVX_BASELINE Fn* get(ISA const tier) const noexcept
+    {
+        return fns[static_cast<std::size_t>(tier)];
+    }
+
+    template<typename... Args>
+    MKN_AVX_BASELINE decltype(auto) operator()(Args&&... args) const
+    {
+        return get()(std::forward<Args>(args)...);
+    }
+
+private:
+    std::array<Fn*, TIERS> fns{};
+    mutable std::atomic<Fn*> best{nullptr};
+};
+
+
+} // namespace mkn::avx
+
+namespace mkn::avx::inline MKN_AVX_TIER
+{
+// the tier this translation unit was compiled for
+ISA constexpr compiled_isa() noexcept
+{
+    if constexpr (Options::AVX512)
+        return ISA::AVX512;
+    else if constexpr (Options::AVX2)
+        return ISA::AVX2;
+    else if constexpr (Options::AVX)
+        return ISA::AVX;
+    else
+        return ISA::NONE;
+}
+
+} // namespace mkn::avx
+
+#define MKN_AVX_DISPATCH_CAT_(a, b) a##b
+#define MKN_AVX_DISPATCH_CAT(a, b) MKN_AVX_DISPATCH_CAT_(a, b)
+
+// registers fn into table at the tier this translation unit is compiled for
+#define MKN_AVX_DISPATCH_REGISTER(table, fn)                                                       \
+    static bool const MKN_AVX_DISPATCH_CAT(_mkn_avx_dispatch_, __LINE__)                           \
+        = ((table).set(mkn::avx::compiled_isa(), fn), true)
+
+#endif /* _MKN_AVX_DISPATCH_HPP_ */
@@ -0,0 +1,354 @@
+/**
+Copyright (c) 2024, Philip Deegan.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+    * Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the following disclaimer
+in the documentation and/or other materials provided with the
+distribution.
+    * Neither the name of Philip Deegan nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef _MKN_AVX_EXPR_HPP_
+#define _MKN_AVX_EXPR_HPP_
+
+#include "mkn/avx/def.hpp"
+#include "mkn/avx/types.hpp"
+#include "mkn/avx/vector.hpp"
+
+#include <cmath>
+#include <tuple>
+#include <cassert>
+#include <cstddef>
+#include <type_traits>
+
+// Expression templates - the op tree is a type and eval is a single loop
+//
+//   auto [a, b, c] = mkn::avx::fused(v0, v1, v2);
+//   auto r = mkn::avx::eval(a * b + c * 2); // new Vector
+//   mkn::avx::eval_into(v0, a * b - c);     // existing storage, may be a leaf
+//
+// every N wide chunk loads each leaf once and intermediate values stay in
+// registers. a * b + c and c + a * b contract to fma, a * b - c to fms and
+// c - a * b to fnma, which round once where the cpu has FMA. The ragged tail is
+// one masked step where supported.
+//
+// Leaves point into the containers they were made from, which must outlive the
+// expression. Nothing is recorded at runtime, unlike LazyVal, so expressions
+// cost nothing to build.
+
+namespace mkn::avx::inline MKN_AVX_TIER::expr
+{
+template<typename T>
+struct Leaf
+{
+    using value_type        = T;
+    auto constexpr static N = Options::N<T>();
+
+    Type<T, N> vec(std::size_t const i) const noexcept { return unaligned_load<T, N>(p + i); }
+    Type<T, N> vec(std::size_t const i, std::size_t const n) const noexcept
+    {
+        return {Type_<T, N>::masked_load(p + i, n)};
+    }
+    T operator[](std::size_t const i) const noexcept { return p[i]; }
+    std::size_t size() const noexcept { return n; }
+
+    T const* p;
+    std::size_t n;
+};
+
+// broadcast, size() 0 matches any size
+template<typename T>
+struct Scalar
+{
+    using value_type        = T;
+    auto constexpr static N = Options::N<T>();
+
+    Type<T, N> vec(std::size_t const = 0) const noexcept { return {Type_<T, N>::set_v(v)}; }
+    Type<T, N> vec(std::size_t const, std::size_t const) const noexcept { return vec(); }
+    T operator[](std::size_t const) const noexcept { return v; }
+    std::size_t size() const noexcept { return 0; }
+
+    T v;
+};
+
+
+// ops apply to Type<T, N> for whole chunks and T for scalar tails
+struct Add
+{
+    static auto apply(auto const& a, auto const& b) noexcept { return a + b; }
+};
+struct Sub
+{
+    static auto apply(auto const& a, auto const& b) noexcept { return a - b; }
+};
+struct Mul
+{
+    static auto apply(auto const& a, auto const& b) noexcept { return a * b; }
+};
+struct Div
+{
+    static auto apply(auto const& a, auto const& b) noexcept { return a / b; }
+};
+
+// a * b + c
+struct Fma
+{
+    static auto apply(auto const& a, auto const& b, auto const& c) noexcept
+    {
+        if constexpr (!Options::FMA)
+            return a * b + c;
+        else if constexpr (std::is_arithmetic_v<std::decay_t<decltype(a)>>)
+            return std::fma(a, b, c);
+        else
+            return fma(a, b, c);
+    }
+};
+// a * b - c
+struct Fms
+{
+    static auto apply(auto const& a, auto const& b, auto const& c) noexcept
+    {
+        if constexpr (!Options::FMA)
+            return a * b - c;
+        else if constexpr (std::is_arithmetic_v<std::decay_t<decltype(a)>>)
+            return std::fma(a, b, -c);
+        else
+            return fms(a, b, c);
+    }
+};
+// c - a * b
+struct Fnma
+{
+    static auto apply(auto const& a, auto const& b, auto const& c) noexcept
+    {
+        if constexpr (!Options::FMA)
+            return c - a * b;
+        else if constexpr (std::is_arithmetic_v<std::decay_t<decltype(a)>>)
+            return std::fma(-a, b, c);
+        else
+            return fnma(a, b, c);
+    }
+};
+
+
+template<typename Op, typename E, typename... Es>
+struct Node
+{
+    using value_type        = typename E::value_type;
+    auto constexpr static N = Options::N<value_type>();
+
+    Type<value_type, N> vec(std::size_t const i) const noexcept
+    {
+        return std::apply([&](auto const&... e) { return Op::apply(e.vec(i)...); }, es);
+    }
+    // the lanes past n are zero, but one in a divisor so there is no 0 / 0
+    Type<value_type, N> vec(std::size_t const i, std::size_t const n) const noexcept
+    {
+        if constexpr (std::is_same_v<Op, Div>)
+        {
+            using Impl         = Type_<value_type, N>;
+            auto const& [a, b] = es;
+            Type<value_type, N> const divisor{Impl::masked_fill(b.vec(i, n)(), n, value_type{1})};
+            return Op::apply(a.vec(i, n), divisor);
+        }
+        else
+            return std::apply([&](auto const&... e) { return Op::apply(e.vec(i, n)...); }, es);
+    }
+    value_type operator[](std::size_t const i) const noexcept
+    {
+        return std::apply([&](auto const&... e) { return Op::apply(e[i]...); }, es);
+    }
+
+    // operands of non zero size must agree
+    std::size_t size() const noexcept
+    {
+        std::size_t ret = 0;
+        std::apply([&](auto const&... e) { ((ret = e.size() > ret ? e.size() : ret), ...); }, es);
+        assert(std::apply(
+            [&](auto const&... e) { return ((e.size() == 0 or e.size() == ret) and ...); }, es));
+        return ret;
+    }
+
+    std::tuple<E, Es...> es;
+};
+
+
+template<typename E>
+struct is_expr : std::false_type
+{
+};
+template<typename T>
+struct is_expr<Leaf<T>> : std::true_type
+{
+};
+template<typename T>
+struct is_expr<Scalar<T>> : std::true_type
+{
+};
+template<typename Op, typename... Es>
+struct is_expr<Node<Op, Es...>> : std::true_type
+{
+};
+template<typename E>
+inline constexpr bool is_expr_v = is_expr<std::decay_t<E>>::value;
+
+template<typename E>
+struct is_mul : std::false_type
+{
+};
+template<typename A, typename B>
+struct is_mul<Node<Mul, A, B>> : std::true_type
+{
+};
+template<typename E>
+inline constexpr bool is_mul_v = is_mul<std::decay_t<E>>::value;
+
+// an expression and an expression or a number
+template<typename A, typename B>
+inline constexpr bool operands_v = (is_expr_v<A> or is_expr_v<B>)
+                                   and (is_expr_v<A> or std::is_arithmetic_v<A>)
+                                   and (is_expr_v<B> or std::is_arithmetic_v<B>);
+
+template<typename A, typename B>
+using value_t = typename std::conditional_t<is_expr_v<A>, A, B>::value_type;
+
+template<typename T, typename E>
+auto as_expr(E const& e) noexcept
+{
+    if constexpr (is_expr_v<E>)
+        return e;
+    else
+        return Scalar<T>{static_cast<T>(e)};
+}
+
+template<typename Op, typename A, typename B>
+auto node(A const& a, B const& b) noexcept
+{
+    using T = value_t<A, B>;
+    auto l  = as_expr<T>(a);
+    auto r  = as_expr<T>(b);
+    return Node<Op, decltype(l), decltype(r)>{{l, r}};
+}
+
+// m is a * b
+template<typename Op, typename M, typename C>
+auto contract(M const& m, C const& c) noexcept
+{
+    auto const& [a, b] = m.es;
+    auto r             = as_expr<typename M::value_type>(c);
+    return Node<Op, std::decay_t<decltype(a)>, std::decay_t<decltype(b)>, decltype(r)>{{a, b, r}};
+}
+
+
+template<typename A, typename B, std::enable_if_t<operands_v<A, B>, bool> = 0>
+auto operator+(A const& a, B const& b) noexcept
+{
+    if constexpr (is_mul_v<A>)
+        return contract<Fma>(a, b);
+    else if constexpr (is_mul_v<B>)
+        return contract<Fma>(b, a);
+    else
+        return node<Add>(a, b);
+}
+
+template<typename A, typename B, std::enable_if_t<operands_v<A, B>, bool> = 0>
+auto operator-(A const& a, B const& b) noexcept
+{
+    if constexpr (is_mul_v<A>)
+        return contract<Fms>(a, b);
+    else if constexpr (is_mul_v<B>)
+        return contract<Fnma>(b, a);
+    else
+        return node<Sub>(a, b);
+}
+
+template<typename A, typename B, std::enable_if_t<operands_v<A, B>, bool> = 0>
+auto operator*(A const& a, B const& b) noexcept
+{
+    return node<Mul>(a, b);
+}
+
+template<typename A, typename B, std::enable_if_t<operands_v<A, B>, bool> = 0>
+auto operator/(A const& a, B const& b) noexcept
+{
+    return node<Div>(a, b);
+}
+
+} // namespace mkn::avx::expr
+
+
+namespace mkn::avx::inline MKN_AVX_TIER
+{
+template<typename Container>
+auto leaf(Container const& c) noexcept
+{
+    return expr::Leaf<std::decay_t<typename Container::value_type>>{c.data(), c.size()};
+}
+
+template<typename... Containers>
+auto fused(Containers const&... cs) noexcept
+{
+    return std::make_tuple(leaf(cs)...);
+}
+
+// dst[i] = e[i] for i in [0, e.size()), dst may be the storage of a leaf
+template<typename E, std::enable_if_t<expr::is_expr_v<E>, bool> = 0>
+void eval_into(typename E::value_type* const dst, E const& e) noexcept
+{
+    using T          = typename E::value_type;
+    auto constexpr N = Options::N<T>();
+    auto const size  = e.size();
+
+    std::size_t i = 0;
+    for (; i + N <= size; i += N)
+        unaligned_store(dst + i, e.vec(i));
+
+    if constexpr (has_masked_v<T, N> and Options::AVX)
+    {
+        if (i < size)
+            Type_<T, N>::masked_store(dst + i, e.vec(i, size - i)(), size - i);
+    }
+    else
+        for (; i < size; ++i)
+            dst[i] = e[i];
+}
+
+template<typename Container, typename E,
+         std::enable_if_t<expr::is_expr_v<E> and !std::is_pointer_v<Container>, bool> = 0>
+void eval_into(Container& dst, E const& e) noexcept
+{
+    assert(dst.size() == e.size());
+    eval_into(dst.data(), e);
+}
+
+template<typename E, std::enable_if_t<expr::is_expr_v<E>, bool> = 0>
+auto eval(E const& e)
+{
+    Vector<typename E::value_type> ret(e.size());
+    eval_into(ret.data(), e);
+    return ret;
+}
+
+} // namespace mkn::avx
+
+#endif /* _MKN_AVX_EXPR_HPP_ */
@@ -38,7 +38,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "mkn/kul/math.hpp"
 #include "mkn/avx/span.hpp"
 
-namespace mkn::avx
+namespace mkn::avx::inline MKN_AVX_TIER
 {
 // SpanT controls the tail contract for row slices produced while iterating:
 // Span (default) requires every sliced row remainder to divide evenly by N;
@@ -0,0 +1,311 @@
+/**
+Copyright (c) 2024, Philip Deegan.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+    * Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the following disclaimer
+in the documentation and/or other materials provided with the
+distribution.
+    * Neither the name of Philip Deegan nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef _MKN_AVX_JIT_HPP_
+#define _MKN_AVX_JIT_HPP_
+
+#include "mkn/avx/def.hpp"
+#include "mkn/avx/lazy.hpp"
+#include "mkn/avx/dispatch.hpp"
+
+#include <mutex>
+#include <string>
+#include <vector>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iterator>
+#include <filesystem>
+#include <unordered_map>
+
+#if !defined(_WIN32)
+#include <dlfcn.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#endif
+
+// Compiled kernels for LazyVal expressions
+//
+//   auto [l0, l1, l2] = mkn::avx::lazy(a0, a1, a2);
+//   auto r = mkn::avx::jit::eval(l0 * l1 + l2);
+//
+// The first eval of an expression structure generates a plain loop, see
+// LazyEvaluator::kernel_source, builds it into a shared object with the host
+// compiler and dlopens it. Objects stay in the cache directory so later evals,
+// in this process or the next, only look up the source and make one call.
+//
+// environment
+//   MKN_AVX_JIT_CACHE  cache directory, default $XDG_CACHE_HOME/mkn.avx.jit
+//                      or ~/.cache/mkn.avx.jit
+//   CXX                compiler, default c++
+//   MKN_AVX_JIT_FLAGS  default -O3 -march=native -ffp-contract=fast
+//
+// the key covers source, compiler, flags, the detected isa and the target the
+// flags resolve to on this machine - the compiler's predefined macros, so
+// -march=native on a cpu with other extensions builds its own object and one
+// cache directory can be shared across different hardware. Each object keeps
+// its source beside it, compared before loading so a colliding key takes the
+// next free name. POSIX only, get() throws on windows.
+//
+// the directory is made 0700, and neither it nor a shared object in it is
+// loaded unless owned by the effective user and not group or world writable
+
+namespace mkn::avx::inline MKN_AVX_TIER::jit
+{
+// FNV-1a
+inline std::uint64_t hash(std::string const& s) noexcept
+{
+    std::uint64_t h = 14695981039346656037ull;
+    for (unsigned char const c : s)
+        h = (h ^ c) * 1099511628211ull;
+    return h;
+}
+
+template<typename T>
+using Kernel = void (*)(T*, T const* const*, std::size_t);
+
+class Cache
+{
+public:
+    Cache(std::filesystem::path _dir = default_dir(), std::string _cxx = env("CXX", "c++"),
+          std::string _flags = env("MKN_AVX_JIT_FLAGS", "-O3 -march=native -ffp-contract=fast"))
+        : dir{std::move(_dir)}
+        , cxx{std::move(_cxx)}
+        , flags{std::move(_flags)}
+    {
+    }
+
+    // kernels from get() are invalid afterwards
+    ~Cache()
+    {
+#if !defined(_WIN32)
+        for (auto* handle : handles)
+            dlclose(handle);
+#endif
+    }
+
+    Cache(Cache const&)            = delete;
+    Cache& operator=(Cache const&) = delete;
+
+    template<typename T>
+    Kernel<T> get(std::string const& source)
+    {
+        return reinterpret_cast<Kernel<T>>(load(source));
+    }
+
+    // shared objects built, rather than found on disk, by this cache
+    std::size_t compiled() const noexcept { return n_compiled; }
+    auto& directory() const noexcept { return dir; }
+
+    static Cache& global()
+    {
+        static Cache cache;
+        return cache;
+    }
+
+    static std::string env(char const* const key, std::string const& fallback)
+    {
+        auto const* v = std::getenv(key);
+        return v and *v ? v : fallback;
+    }
+
+    static std::filesystem::path default_dir()
+    {
+        if (auto const dir = env("MKN_AVX_JIT_CACHE", ""); !dir.empty())
+            return dir;
+        if (auto const xdg = env("XDG_CACHE_HOME", ""); !xdg.empty())
+            return std::filesystem::path{xdg} / "mkn.avx.jit";
+        if (auto const home = env("HOME", ""); !home.empty())
+            return std::filesystem::path{home} / ".cache" / "mkn.avx.jit";
+#if defined(_WIN32)
+        return std::filesystem::temp_directory_path() / "mkn.avx.jit";
+#else
+        return std::filesystem::temp_directory_path()
+             / ("mkn.avx.jit." + std::to_string(::geteuid()));
+#endif
+    }
+
+private:
+    void* load(std::string const& source)
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        if (auto const it = symbols.find(source); it != symbols.end())
+            return it->second;
+
+#if defined(_WIN32)
+        KEXCEPT(Exception, "mkn::avx::jit is not supported on windows");
+#else
+        if (target.empty())
+            target = probe();
+        auto const key = hex(hash(cxx + "\n" + flags + "\n" + to_string(isa()) + "\n" + target
+                                  + "\n" + source));
+
+        make_dir();
+        std::filesystem::path so;
+        for (std::size_t i = 0;; ++i)
+        {
+            auto const name = "mkn_avx_" + key + (i ? "." + std::to_string(i) : "");
+            so              = dir / (name + ".so");
+            if (!std::filesystem::exists(so))
+            {
+                compile(name, source, so);
+                break;
+            }
+            if (read(dir / (name + ".cpp")) == source)
+                break;
+        }
+        if (!trusted(so, S_IFREG))
+            KEXCEPT(Exception, "mkn::avx::jit refusing to load " + so.string());
+
+        auto* handle = dlopen(so.c_str(), RTLD_NOW | RTLD_LOCAL);
+        if (!handle)
+            KEXCEPT(Exception, "mkn::avx::jit dlopen failed: " + std::string{dlerror()});
+        auto* sym = dlsym(handle, "mkn_avx_kernel");
+        if (!sym)
+        {
+            dlclose(handle);
+            KEXCEPT(Exception, "mkn::avx::jit no kernel in " + so.string());
+        }
+        handles.emplace_back(handle);
+        return symbols[source] = sym;
+#endif
+    }
+
+#if !defined(_WIN32)
+    // built under a per process name and renamed into place, racing processes
+    // produce the same object. the source goes first so an object always has it
+    void compile(std::string const& name, std::string const& source,
+                 std::filesystem::path const& so)
+    {
+        auto const tag = name + ".tmp." + std::to_string(::getpid());
+        auto const src = dir / (tag + ".cpp");
+        auto const tmp = dir / (tag + ".so");
+        auto const log = dir / (tag + ".log");
+        std::ofstream{src} << source;
+
+        auto const quote = [](auto const& p) { return std::string{"'"}.append(p.string()) += "'"; };
+        auto const cmd   = cxx + " " + flags + " -shared -fPIC -o " + quote(tmp) + " " + quote(src)
+                         + " > " + quote(log) + " 2>&1";
+        if (std::system(cmd.c_str()) != 0)
+            KEXCEPT(Exception, "mkn::avx::jit compile failed, see " + log.string());
+
+        std::filesystem::permissions(tmp, std::filesystem::perms::owner_all);
+        std::filesystem::rename(src, dir / (name + ".cpp"));
+        std::filesystem::rename(tmp, so);
+        std::filesystem::remove(log);
+        ++n_compiled;
+    }
+
+    // predefined macros of cxx under flags, empty if it cannot be run
+    std::string probe() const
+    {
+        std::string ret;
+        auto const cmd = cxx + " " + flags + " -dM -E -x c++ /dev/null 2>/dev/null";
+        if (auto* pipe = ::popen(cmd.c_str(), "r"))
+        {
+            char buf[4096];
+            for (std::size_t n; (n = std::fread(buf, 1, sizeof(buf), pipe)) > 0;)
+                ret.append(buf, n);
+            ::pclose(pipe);
+        }
+        return ret.empty() ? "-" : ret;
+    }
+
+    static std::string read(std::filesystem::path const& p)
+    {
+        std::ifstream in{p, std::ios::binary};
+        return {std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+    }
+
+    // 0700 if missing, parents as usual
+    void make_dir() const
+    {
+        if (dir.has_parent_path())
+            std::filesystem::create_directories(dir.parent_path());
+        if (::mkdir(dir.c_str(), S_IRWXU) != 0 and errno != EEXIST)
+            KEXCEPT(Exception, "mkn::avx::jit cannot create " + dir.string());
+        if (!trusted(dir, S_IFDIR))
+            KEXCEPT(Exception, "mkn::avx::jit refusing cache directory " + dir.string());
+    }
+
+    // not a symlink, owned by the effective user and writable by no one else
+    static bool trusted(std::filesystem::path const& p, mode_t const type)
+    {
+        struct stat st;
+        return ::lstat(p.c_str(), &st) == 0 and (st.st_mode & S_IFMT) == type
+           and st.st_uid == ::geteuid() and (st.st_mode & (S_IWGRP | S_IWOTH)) == 0;
+    }
+#endif
+
+    static std::string hex(std::uint64_t v)
+    {
+        std::string ret(16, '0');
+        for (std::size_t i = 16; i-- > 0; v >>= 4)
+            ret[i] = "0123456789abcdef"[v & 0xf];
+        return ret;
+    }
+
+    std::filesystem::path const dir;
+    std::string const cxx, flags;
+    std::string target; // see probe
+
+    std::mutex mutex;
+    std::unordered_map<std::string, void*> symbols; // by source
+    std::vector<void*> handles;
+    std::size_t n_compiled = 0;
+};
+
+
+// as mkn::avx::eval, through a compiled kernel
+template<typename T>
+auto eval(LazyVal<T>& v, Cache& cache = Cache::global())
+{
+    using E = typename T::value_type;
+
+    LazyEvaluator<LazyVal<T>> evaluator{v};
+    std::vector<E const*> inputs;
+    auto const kernel = cache.get<E>(evaluator.kernel_source(inputs));
+
+    T ret(v().size());
+    kernel(ret.data(), inputs.data(), ret.size());
+    return ret;
+}
+
+template<typename T>
+auto eval(LazyVal<T>&& v, Cache& cache = Cache::global())
+{
+    return eval(v, cache);
+}
+
+} // namespace mkn::avx::jit
+
+#endif /* _MKN_AVX_JIT_HPP_ */
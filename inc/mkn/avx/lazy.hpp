@@ -34,44 +34,158 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "mkn/kul/io.hpp"
 #include "mkn/kul/alloc.hpp"
 
+
 #include "mkn/avx/span.hpp"
+#include "mkn/avx/arena.hpp"
+#include "mkn/avx/array.hpp"
+#include "mkn/avx/vector.hpp"
+#include "mkn/avx/parallel.hpp"
 
-#include <new>
+#include <map>
+#include <mutex>
+#include <array>
 #include <tuple>
+#include <atomic>
+#include <chrono>
+#include <string>
 #include <vector>
 #include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <algorithm>
 
-namespace mkn::avx
+namespace mkn::avx::inline MKN_AVX_TIER
 {
 
+// op is 0-3 for + - * /, 4 and 5 for c - a and c / a with c on the left,
+// 6 and 7 for min and max, 8-11 for sqrt abs neg exp of a alone. a and b
+// are vectors, or earlier ops of the same graph where na and nb are set
 template<typename T, typename Small = std::uint16_t>
 struct LazyOp
 {
-    LazyOp(T* _a, T const* _b, std::size_t const& _op)
+    using Reg = std::array<typename T::value_type, Options::N<typename T::value_type>()>;
+
+    Small static constexpr leaf = std::numeric_limits<Small>::max();
+
+    LazyOp() = default;
+    LazyOp(T* _a, Small const _na, T const* _b, Small const _nb, std::size_t const& _op)
         : a{_a}
         , b{_b}
         , op{_op}
+        , na{_na}
+        , nb{_nb}
+    {
+    }
+    LazyOp(T* _a, Small const _na, Reg const& _c, std::size_t const& _op)
+        : a{_a}
+        , op{_op}
+        , na{_na}
+        , c{_c}
+    {
+    }
+    LazyOp(T* _a, Small const _na, std::size_t const& _op)
+        : a{_a}
+        , op{_op}
+        , na{_na}
+    {
+    }
+
+    bool unary() const { return op > 7; }
+    bool broadcast() const { return !unary() and !b and nb == leaf; }
+
+    T* a       = nullptr;
+    T const* b = nullptr; // nullptr for broadcast c, unary or nb
+    std::size_t op = 0;
+    Small na = leaf, nb = leaf;
+    Reg c{};
+};
+
+// the ops of one expression in record order, each reading vectors or earlier
+// ops. The first few are held inline so most expressions are one allocation,
+// from arena if given else the heap
+template<typename T>
+class LazyGraph
+{
+public:
+    using Op                              = LazyOp<T>;
+    using Small                           = std::remove_const_t<decltype(Op::leaf)>;
+    std::size_t static constexpr in_place = 8;
+
+    explicit LazyGraph(Arena* const arena)
+        : more(ArenaAllocator<Op>{arena})
+    {
+    }
+    LazyGraph(LazyGraph const& that, Arena* const arena)
+        : n{that.n}
+        , local{that.local}
+        , more(that.more, ArenaAllocator<Op>{arena})
+    {
+    }
+
+    std::size_t size() const { return n; }
+
+    Op const& operator[](std::size_t const i) const
     {
+        return i < in_place ? local[i] : more[i - in_place];
     }
 
+    Small emplace_back(Op const& op)
+    {
+        assert(n < Op::leaf);
+        if (n < in_place)
+            local[n] = op;
+        else
+            more.emplace_back(op);
+        return n++;
+    }
+
+    // ops up to node of that, renumbered after the ops here, returns node
+    Small append(LazyGraph const& that, Small const node)
+    {
+        auto const off = static_cast<Small>(n);
+        for (std::size_t i = 0; i <= node; ++i)
+        {
+            auto op = that[i];
+            if (op.na != Op::leaf)
+                op.na += off;
+            if (op.nb != Op::leaf)
+                op.nb += off;
+            emplace_back(op);
+        }
+        return node + off;
+    }
 
-    T* a;
-    T const* b;
-    std::size_t op;
-    Small t      = 0;
-    LazyOp* prev = nullptr;
-    LazyOp* next = nullptr;
+private:
+    std::size_t n = 0;
+    std::array<Op, in_place> local;
+    std::vector<Op, ArenaAllocator<Op>> more;
 };
 
+// a vector, or an expression over vectors. Each expression owns its graph,
+// shared by its copies and extended in place only when nothing else holds
+// it, so expressions can be built in any order or on any thread and kept to
+// evaluate later - see LazyPlan
 template<typename T>
 struct LazyVal
 {
-    static thread_local inline std::size_t alive = 0;
-    using value_type                             = T;
-    using This                                   = LazyVal<T>;
+    using value_type = T;
+    using This       = LazyVal<T>;
+    using E          = typename T::value_type;
+    using Op         = LazyOp<T>;
+    using Reg        = typename Op::Reg;
+    using Graph      = LazyGraph<T>;
+    using Small      = typename Graph::Small;
+
+    // scalars and Array<E, N> are broadcast, an Array is one register of lanes
+    template<typename C>
+    bool static constexpr is_broadcast_v
+        = std::is_arithmetic_v<C> or std::is_same_v<C, Array<E, std::tuple_size_v<Reg>>>;
 
-    LazyVal(T& t)
+    LazyVal(T& t, Arena* const _arena = nullptr)
         : v{&t}
+        , arena{_arena}
     {
     }
     ~LazyVal() {}
@@ -80,175 +194,798 @@ struct LazyVal
     LazyVal(LazyVal&& that)      = default;
 
 
-    auto operator+(This const& that) const
+    friend auto operator+(This a, This const& b) { return record(std::move(a), &b, 0); }
+    friend auto operator-(This a, This const& b) { return record(std::move(a), &b, 1); }
+    friend auto operator*(This a, This const& b) { return record(std::move(a), &b, 2); }
+    friend auto operator/(This a, This const& b) { return record(std::move(a), &b, 3); }
+
+    template<typename C, std::enable_if_t<is_broadcast_v<C>, bool> = 0>
+    friend auto operator+(This a, C const& c)
     {
-        operands.emplace_back(v, that.v, 0);
-        return *this;
+        return broadcast(std::move(a), c, 0);
     }
-    auto operator-(This const& that) const
+    template<typename C, std::enable_if_t<is_broadcast_v<C>, bool> = 0>
+    friend auto operator-(This a, C const& c)
     {
-        operands.emplace_back(v, that.v, 1);
-        return *this;
+        return broadcast(std::move(a), c, 1);
+    }
+    template<typename C, std::enable_if_t<is_broadcast_v<C>, bool> = 0>
+    friend auto operator*(This a, C const& c)
+    {
+        return broadcast(std::move(a), c, 2);
+    }
+    template<typename C, std::enable_if_t<is_broadcast_v<C>, bool> = 0>
+    friend auto operator/(This a, C const& c)
+    {
+        return broadcast(std::move(a), c, 3);
     }
 
-    auto operator*(This const& that) const
+    template<typename C, std::enable_if_t<is_broadcast_v<C>, bool> = 0>
+    friend auto operator+(C const& c, This a)
     {
-        operands.emplace_back(v, that.v, 2);
-        return *this;
+        return broadcast(std::move(a), c, 0);
     }
-    auto operator/(This const& that) const
+    template<typename C, std::enable_if_t<is_broadcast_v<C>, bool> = 0>
+    friend auto operator-(C const& c, This a)
     {
-        operands.emplace_back(v, that.v, 3);
-        return *this;
+        return broadcast(std::move(a), c, 4);
     }
+    template<typename C, std::enable_if_t<is_broadcast_v<C>, bool> = 0>
+    friend auto operator*(C const& c, This a)
+    {
+        return broadcast(std::move(a), c, 2);
+    }
+    template<typename C, std::enable_if_t<is_broadcast_v<C>, bool> = 0>
+    friend auto operator/(C const& c, This a)
+    {
+        return broadcast(std::move(a), c, 5);
+    }
+
+    friend auto operator-(This a) { return record(std::move(a), nullptr, 10); }
 
     auto& operator()() { return *v; }
     auto& operator()() const { return *v; }
 
+    template<typename C>
+    static This broadcast(This a, C const& c, std::size_t const op)
+    {
+        Reg reg;
+        if constexpr (std::is_arithmetic_v<C>)
+            reg.fill(static_cast<E>(c));
+        else
+            std::copy(c.begin(), c.end(), reg.begin());
+        return record(std::move(a), nullptr, op, &reg);
+    }
+
+    // a op b, or op on a alone without b or c. a's graph is extended if a
+    // holds the only reference, as a temporary does, else copied - b's ops
+    // follow unless they are already there. A new graph is from a's arena, or
+    // b's if a is a vector, or the heap
+    static This record(This a, This const* b, std::size_t const op, Reg const* c = nullptr)
+    {
+        bool const same = b and b->graph and b->graph == a.graph;
+        if (!a.graph and !a.arena and b)
+            a.arena = b->arena;
+        ArenaAllocator<Graph> const alloc{a.arena};
+        if (!a.graph)
+            a.graph = std::allocate_shared<Graph>(alloc, a.arena);
+        else if (a.graph.use_count() > 1)
+            a.graph = std::allocate_shared<Graph>(alloc, *a.graph, a.arena);
 
-    bool muldiv(std::size_t const& i) const { return operands[i].op == 2 or operands[i].op == 3; }
+        auto* const va = a.node == Op::leaf ? a.v : nullptr;
+        if (c)
+            a.node = a.graph->emplace_back(Op{va, a.node, *c, op});
+        else if (!b)
+            a.node = a.graph->emplace_back(Op{va, a.node, op});
+        else
+        {
+            Small const nb = !b->graph ? Op::leaf
+                           : same      ? b->node
+                                       : a.graph->append(*b->graph, b->node);
+            auto* const vb = nb == Op::leaf ? b->v : nullptr;
+            a.node         = a.graph->emplace_back(Op{va, a.node, vb, nb, op});
+        }
+        return a;
+    }
 
-    T* v;
-    static inline thread_local std::vector<LazyOp<T>> operands;
+    T* v;                         // first vector, the result operand
+    std::shared_ptr<Graph> graph; // nullptr for a vector
+    Small node   = Op::leaf;      // last op of graph
+    Arena* arena = nullptr;       // of graph, nullptr for the heap
 };
 
+// elementwise functions, recorded as the operators are
+//   auto r = eval(sqrt(l0 * l0 + l1 * l1));
+//   auto q = eval(clamp(l0 - l1, -1.0, 1.0));
+template<typename T>
+auto sqrt(LazyVal<T> x)
+{
+    static_assert(std::is_floating_point_v<typename T::value_type>, "floating point lanes only");
+    return LazyVal<T>::record(std::move(x), nullptr, 8);
+}
+template<typename T>
+auto abs(LazyVal<T> x)
+{
+    static_assert(std::is_floating_point_v<typename T::value_type>, "floating point lanes only");
+    return LazyVal<T>::record(std::move(x), nullptr, 9);
+}
+template<typename T>
+auto neg(LazyVal<T> x)
+{
+    static_assert(std::is_floating_point_v<typename T::value_type>, "floating point lanes only");
+    return LazyVal<T>::record(std::move(x), nullptr, 10);
+}
+template<typename T>
+auto exp(LazyVal<T> x)
+{
+    static_assert(std::is_floating_point_v<typename T::value_type>, "floating point lanes only");
+    return LazyVal<T>::record(std::move(x), nullptr, 11);
+}
 
+template<typename T>
+auto min(LazyVal<T> a, LazyVal<T> const& b)
+{
+    return LazyVal<T>::record(std::move(a), &b, 6);
+}
+template<typename T, typename C, std::enable_if_t<LazyVal<T>::template is_broadcast_v<C>, bool> = 0>
+auto min(LazyVal<T> a, C const& c)
+{
+    return LazyVal<T>::broadcast(std::move(a), c, 6);
+}
+template<typename T, typename C, std::enable_if_t<LazyVal<T>::template is_broadcast_v<C>, bool> = 0>
+auto min(C const& c, LazyVal<T> a)
+{
+    return LazyVal<T>::broadcast(std::move(a), c, 6);
+}
 
-template<typename LazyVal_t>
-struct LazyEvaluator
+template<typename T>
+auto max(LazyVal<T> a, LazyVal<T> const& b)
 {
-    using Vec_t             = typename LazyVal_t::value_type;
+    return LazyVal<T>::record(std::move(a), &b, 7);
+}
+template<typename T, typename C, std::enable_if_t<LazyVal<T>::template is_broadcast_v<C>, bool> = 0>
+auto max(LazyVal<T> a, C const& c)
+{
+    return LazyVal<T>::broadcast(std::move(a), c, 7);
+}
+template<typename T, typename C, std::enable_if_t<LazyVal<T>::template is_broadcast_v<C>, bool> = 0>
+auto max(C const& c, LazyVal<T> a)
+{
+    return LazyVal<T>::broadcast(std::move(a), c, 7);
+}
+
+// min(max(x, lo), hi), lo and hi as the operands of min and max
+template<typename T, typename Lo, typename Hi>
+auto clamp(LazyVal<T> x, Lo const& lo, Hi const& hi)
+{
+    return min(max(std::move(x), lo), hi);
+}
+template<typename T> // over std::clamp, found through T
+auto clamp(LazyVal<T> x, LazyVal<T> const& lo, LazyVal<T> const& hi)
+{
+    return min(max(std::move(x), lo), hi);
+}
+
+
+// compiled form of the recorded operands, one instruction per span op
+//   FMA  a * b + c
+//   FMS  a * b - c
+//   FNMA c - a * b
+//   MOV and after, a alone
+enum class LazyCode : std::uint8_t {
+    ADD = 0,
+    SUB,
+    MUL,
+    DIV,
+    FMA,
+    FMS,
+    FNMA,
+    MIN,
+    MAX,
+    MOV,
+    SQRT,
+    ABS,
+    NEG,
+    EXP
+};
+
+struct LazyArg
+{
+    enum Kind : std::uint8_t { RET = 0, TMP, IN, BCAST };
+
+    Kind kind         = RET;
+    std::uint16_t idx = 0; // tmp slot, input or constant
+
+    bool operator==(LazyArg const& that) const { return kind == that.kind and idx == that.idx; }
+};
+
+struct LazyInstr
+{
+    LazyCode code;
+    LazyArg dst{};
+    std::array<LazyArg, 3> src{}; // src[2] for fused codes only
+
+    bool fused() const { return code >= LazyCode::FMA and code <= LazyCode::FNMA; }
+    std::size_t operands() const { return fused() ? 3 : code >= LazyCode::MOV ? 1 : 2; }
+};
+
+// fastest block, in vectors, per expression shape - see LazyProgram::tune.
+// Evaluation reads it, and tunes shapes it has not seen once enabled, by
+// enable() or MKN_AVX_LAZY_TUNE=1
+class LazyTuning
+{
+public:
+    static LazyTuning& global()
+    {
+        static LazyTuning tuning;
+        return tuning;
+    }
+
+    bool enabled() const { return on.load(std::memory_order_relaxed); }
+    LazyTuning& enable(bool const tune = true)
+    {
+        on.store(tune, std::memory_order_relaxed);
+        return *this;
+    }
+
+    bool empty() const { return size.load(std::memory_order_relaxed) == 0; }
+
+    // 0 if not tuned
+    std::size_t find(std::string const& shape) const
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        auto const it = blocks.find(shape);
+        return it == blocks.end() ? 0 : it->second;
+    }
+
+    void emplace(std::string const& shape, std::size_t const block)
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        blocks[shape] = block;
+        size.store(blocks.size(), std::memory_order_relaxed);
+    }
+
+    LazyTuning& clear()
+    {
+        std::lock_guard<std::mutex> lock{mutex};
+        blocks.clear();
+        size.store(0, std::memory_order_relaxed);
+        return *this;
+    }
+
+private:
+    LazyTuning()
+    {
+        auto const* env = std::getenv("MKN_AVX_LAZY_TUNE");
+        on.store(env and std::string{env} != "0");
+    }
+
+    std::atomic<bool> on{false};
+    std::atomic<std::size_t> size{0};
+    mutable std::mutex mutex;
+    std::map<std::string, std::size_t> blocks;
+};
+
+
+// compiled form of a lazy expression and its interpreter, see
+// LazyEvaluator::compile
+template<typename Vec>
+struct LazyProgram
+{
+    using Vec_t             = Vec;
     using T                 = typename Vec_t::value_type;
     using Span_t            = mkn::avx::Span<T>;
     using Span_ct           = mkn::avx::Span<T const>;
+    using Tail_t            = mkn::avx::AsymmetricSpan<T>;
+    using Tail_ct           = mkn::avx::AsymmetricSpan<T const>;
+    using Reg               = typename LazyOp<Vec_t>::Reg;
     auto constexpr static N = mkn::avx::Options::N<T>(); // max vector size
 
-    LazyEvaluator(LazyVal_t& _t)
-        : t{_t}
+    bool constexpr static fp = std::is_floating_point_v<T>; // sqrt, abs, neg and exp
+
+    // r = code(a, b, c), a switch rather than a table of calls so each span
+    // op is inlined into run
+    template<typename S, typename S_c>
+    static void apply(LazyCode const code, S& r, S_c const& a, S_c const& b, S_c const& c)
     {
+        switch (code)
+        {
+            case LazyCode::ADD: r.add(a, b); break;
+            case LazyCode::SUB: r.sub(a, b); break;
+            case LazyCode::MUL: r.mul(a, b); break;
+            case LazyCode::DIV: r.div(a, b); break;
+            case LazyCode::FMA: r.fma(a, b, c); break;
+            case LazyCode::FMS: r.fms(a, b, c); break;
+            case LazyCode::FNMA: r.fnma(a, b, c); break;
+            case LazyCode::MIN: r.min(a, b); break;
+            case LazyCode::MAX: r.max(a, b); break;
+            case LazyCode::MOV:
+                if (r().data() != a().data())
+                    std::copy_n(a().data(), a().size(), r().data());
+                break;
+            // sqrt, abs, neg and exp record these for floating point lanes only
+            case LazyCode::SQRT: if constexpr (fp) r.sqrt(a); break;
+            case LazyCode::ABS: if constexpr (fp) r.abs(a); break;
+            case LazyCode::NEG: if constexpr (fp) r.neg(a); break;
+            case LazyCode::EXP: if constexpr (fp) r.exp(a); break;
+        }
     }
 
-    ~LazyEvaluator() { clear(); }
+    // ret = the program over the size of v, the result operand. policy splits
+    // whole blocks, see parallel.hpp - tmps are thread_local so every worker
+    // prepares its own. ret may be any input, or disjoint from all of them.
+    // Nothing outside [0, size) of ret or an input is read or written, the
+    // last partial block runs on AsymmetricSpan - whole vectors then one
+    // masked step, or scalar where the width has none - so no padding is
+    // needed past the end
+    template<typename Policy>
+    void execute(T* const ret, Vec_t const& v, Policy const& policy) const
+    {
+        auto const& size = v.size();
+        auto const alias = aliased(ret);
+
+        std::size_t const block  = batch() * N;
+        std::size_t const blocks = size / block;
+        policy(blocks, block * sizeof(T), ret, [&](auto const begin, auto const end) {
+            prepare();
+            for (std::size_t b = begin; b < end; ++b)
+                run<Span_t, Span_ct>(ret + b * block, b * block, block, alias);
+        });
+        if (auto const off = blocks * block; off < size)
+        {
+            prepare();
+            run<Tail_t, Tail_ct>(ret + off, off, size - off, alias);
+        }
+    }
 
-    void clear()
+    // op folded over the program's result from init, block by block in a
+    // register, the result is never stored - see sum, min and max. op takes
+    // two vectors or two values, partial results are combined in order
+    template<typename Op, typename Policy>
+    T fold(Vec_t const& v, Op const& op, T const init, Policy const& policy) const
     {
-        tmps.clear();
-        LazyVal_t::operands.clear();
+        using AVX_t = Type<T, N>;
+
+        auto const& size         = v.size();
+        std::size_t const block  = batch() * N;
+        std::size_t const blocks = size / block;
+        auto const out           = [&]() { return tmps[(slots + consts.size()) * batch()].data(); };
+
+        std::mutex mutex;
+        std::vector<std::pair<std::size_t, T>> parts;
+        policy(blocks, block * sizeof(T), nullptr, [&](auto const begin, auto const end) {
+            prepare();
+            AVX_t acc{Type_<T, N>::set_v(init)};
+            for (std::size_t b = begin; b < end; ++b)
+            {
+                run<Span_t, Span_ct>(out(), b * block, block, inputs.size());
+                for (std::size_t i = 0; i < block; i += N)
+                    acc = op(acc, unaligned_load<T, N>(out() + i));
+            }
+            std::lock_guard<std::mutex> lock{mutex};
+            parts.emplace_back(begin, mkn::avx::reduce(acc, op));
+        });
+
+        std::sort(parts.begin(), parts.end());
+        T ret = init;
+        for (auto const& [begin, part] : parts)
+            ret = op(ret, part);
+        if (auto const off = blocks * block; off < size)
+        {
+            prepare();
+            run<Tail_t, Tail_ct>(out(), off, size - off, inputs.size());
+            for (std::size_t i = 0; i < size - off; ++i)
+                ret = op(ret, out()[i]);
+        }
+        return ret;
     }
 
-    static constexpr inline auto __add__
-        = [](Span_t& r, Span_ct const& a, Span_ct const& b) mutable { r.add(a, b); };
-    static constexpr inline auto __sub__
-        = [](Span_t& r, Span_ct const& a, Span_ct const& b) mutable { r.sub(a, b); };
-    static constexpr inline auto __mul__
-        = [](Span_t& r, Span_ct const& a, Span_ct const& b) mutable { r.mul(a, b); };
-    static constexpr inline auto __div__
-        = [](Span_t& r, Span_ct const& a, Span_ct const& b) mutable { r.div(a, b); };
+    // vectors per block
+    std::size_t batch() const { return block_size ? block_size : default_batch(); }
 
-    void compile()
+    // a KiB, every tmp slot of a block stays in L1 with the inputs streaming
+    // past - one cache line leaves the loop overhead per instruction dominant
+    std::size_t static default_batch() { return std::max<std::size_t>(1, 1024 / sizeof(T) / N); }
+
+    // instruction codes, operand kinds and counts, the size class, and the
+    // policy with its thread count - the key block sizes are tuned by
+    template<typename Policy>
+    std::string shape(std::size_t const size, Policy const& policy) const
     {
-        tmps.resize(t.operands.size() - 1);
-        for (size_t i = t.operands.size(); i-- > 0;)
+        std::size_t bits = 0;
+        for (auto s = size; s; s >>= 1)
+            ++bits;
+
+        std::stringstream ss;
+        ss << sizeof(T) << ',' << N << ',' << bits << ',' << slots << ',' << consts.size() << ','
+           << inputs.size() << ',' << (std::is_same_v<Policy, Parallel> ? 'p' : 's')
+           << policy.concurrency();
+        for (auto const& instr : instrs)
         {
-            auto& op = t.operands[i];
+            ss << ' ' << static_cast<int>(instr.code) << static_cast<int>(instr.dst.kind);
+            for (std::size_t s = 0; s < instr.operands(); ++s)
+                ss << static_cast<int>(instr.src[s].kind);
+        }
+        return ss.str();
+    }
 
-            for (size_t j = i; j-- > 0;)
-            {
-                auto& jop = t.operands[j];
-                if (jop.next)
-                    continue;
-                if (jop.a == op.b)
-                {
-                    op.prev  = &jop;
-                    jop.next = &op;
+    // block sizes of 1 to 128 vectors that fit the size of v, each timed as
+    // the best of two runs into ret and the fastest kept for the shape. Shapes
+    // tuned before are not timed again, nor is a ret that is also an input as
+    // each run would read the last, otherwise ret is only scratch
+    template<typename Policy>
+    std::size_t tune(T* const ret, Vec_t const& v, Policy const& policy)
+    {
+        using clock = std::chrono::steady_clock;
 
-                    break;
-                }
+        auto const key = shape(v.size(), policy);
+        if (auto const block = LazyTuning::global().find(key))
+            return block_size = block;
+        if (std::any_of(inputs.begin(), inputs.end(),
+                        [&](auto const& in) { return in->data() == ret; }))
+            return batch();
+
+        std::size_t best_block = default_batch();
+        auto best              = clock::duration::max();
+        for (std::size_t block = 1; block <= 128 and (block == 1 or block * N <= v.size());
+             block *= 2)
+        {
+            block_size = block;
+            auto took  = clock::duration::max();
+            for (std::size_t r = 0; r < 2; ++r)
+            {
+                auto const start = clock::now();
+                execute(ret, v, policy);
+                took = std::min<clock::duration>(took, clock::now() - start);
             }
+            if (took < best)
+                best = took, best_block = block;
         }
+        LazyTuning::global().emplace(key, best_block);
+        return block_size = best_block;
     }
 
-    auto operator()(T* const ret, bool fill = false)
+    // the tuned block for the shape at size under policy, if there is one
+    template<typename Policy>
+    void use_tuned(std::size_t const size, Policy const& policy)
     {
-        compile();
-        auto const& size = t.operands[0].a->size();
+        if (!LazyTuning::global().empty())
+            block_size = LazyTuning::global().find(shape(size, policy));
+    }
 
-        if (fill)
-            std::copy(t.operands[0].a->data(), t.operands[0].a->data() + size, ret);
+    // the input at ret if it is read after ret is written, else inputs.size()
+    std::size_t aliased(T const* const ret) const
+    {
+        bool written = false;
+        for (auto const& instr : instrs)
+        {
+            for (std::size_t s = 0; written and s < instr.operands(); ++s)
+                if (auto const& src = instr.src[s];
+                    src.kind == LazyArg::IN and inputs[src.idx]->data() == ret)
+                    return src.idx;
+            written = written or instr.dst.kind == LazyArg::RET;
+        }
+        return inputs.size();
+    }
 
-        std::size_t tmp = 0;
-        auto do_avx     = [&](auto const& o, auto const& i) {
-            std::size_t const off = i * N;
-            assert(off < size);
+    // tmp slot s of the block is tmps[s * batch, (s + 1) * batch),
+    // constants follow the slots, one block each, then a block for fold and
+    // one for an aliased input. tmps is never shrunk, a thread allocates only
+    // for its largest program
+    void prepare() const
+    {
+        tmps.resize((slots + consts.size() + 2) * batch());
+        for (std::size_t c = 0; c < consts.size(); ++c)
+            std::fill_n(tmps.begin() + (slots + c) * batch(), batch(), consts[c]);
+    }
 
-            auto& op           = t.operands[o];
-            bool const use_tmp = op.a != t.v;
-            Span_ct const a{op.a->data() + off, N};
-            Span_ct const b{op.b->data() + off, N};
-            Span_t r{ret + off, N};
+    // instrs over [off, off + n) of the inputs into out, tmp slots hold one block.
+    // input alias, see aliased, is read from a copy of its block made before
+    // anything is written
+    template<typename S, typename S_c>
+    void run(T* const out, std::size_t const off, std::size_t const n,
+             std::size_t const alias) const
+    {
+        std::size_t const batch = this->batch();
+        T* const copy           = tmps[(slots + consts.size() + 1) * batch].data();
+        if (alias < inputs.size())
+            std::copy_n(inputs[alias]->data() + off, n, copy);
 
-            if (op.prev)
-            {
-                if (use_tmp)
-                {
-                    Span_ct const pspan{tmps[op.prev->t].data(), N};
-                    Span_t tspan{tmps[tmp].data(), N};
-                    fns[op.op](tspan, a, pspan);
+        auto const ptr = [&](LazyArg const& arg) -> T* {
+            if (arg.kind == LazyArg::TMP)
+                return tmps[arg.idx * batch].data();
+            if (arg.kind == LazyArg::BCAST)
+                return tmps[(slots + arg.idx) * batch].data();
+            if (arg.kind == LazyArg::IN)
+                return arg.idx == alias ? copy : const_cast<T*>(inputs[arg.idx]->data()) + off;
+            return out;
+        };
+        for (auto const& in : instrs)
+        {
+            auto const src = [&](std::size_t const s) {
+                return s < in.operands() ? S_c{ptr(in.src[s]), n} : S_c{nullptr, 0};
+            };
+            S r{ptr(in.dst), n};
+            apply<S, S_c>(in.code, r, src(0), src(1), src(2));
+        }
+    }
 
-                    op.t = tmp++;
-                }
-                else
+
+    std::vector<LazyInstr> instrs;
+    std::vector<Vec_t const*> inputs; // LazyArg::IN
+    std::vector<Reg> consts;          // LazyArg::BCAST
+    std::size_t slots = 0;            // LazyArg::TMP
+    std::size_t block_size = 0;       // vectors per block, 0 for default_batch()
+
+    template<typename E>
+    using AVXVec = std::vector<E, mkn::kul::AlignedAllocator<E, Options::ALIGN()>>;
+    static inline thread_local AVXVec<std::array<T, N>> tmps{};
+};
+
+
+template<typename LazyVal_t>
+struct LazyEvaluator : public LazyProgram<typename LazyVal_t::value_type>
+{
+    using Super = LazyProgram<typename LazyVal_t::value_type>;
+    using typename Super::Reg;
+    using typename Super::T;
+    using typename Super::Vec_t;
+    using Super::consts;
+    using Super::inputs;
+    using Super::instrs;
+    using Super::N;
+    using Super::slots;
+
+    LazyEvaluator(LazyVal_t& _t)
+        : t{_t}
+    {
+    }
+
+    std::size_t constexpr static npos = -1;
+
+    // by LazyOp::op
+    std::array<LazyCode, 12> constexpr static codes{
+        LazyCode::ADD, LazyCode::SUB, LazyCode::MUL,  LazyCode::DIV, LazyCode::SUB, LazyCode::DIV,
+        LazyCode::MIN, LazyCode::MAX, LazyCode::SQRT, LazyCode::ABS, LazyCode::NEG, LazyCode::EXP};
+
+    struct Ref // compile() value, a node, an input or a constant
+    {
+        std::size_t node = npos;
+        Vec_t const* in  = nullptr;
+        std::size_t c    = npos;
+
+        auto tie() const { return std::make_tuple(node, in, c); }
+        bool operator<(Ref const& that) const { return tie() < that.tie(); }
+        bool operator==(Ref const& that) const { return tie() == that.tie(); }
+        bool operator!=(Ref const& that) const { return tie() != that.tie(); }
+    };
+    struct Node
+    {
+        LazyCode code;
+        std::array<Ref, 3> src{};
+        bool root        = false;
+        bool live        = false;
+        std::size_t uses = 0, slot = 0;
+
+        std::size_t operands() const { return LazyInstr{code}.operands(); }
+    };
+
+    // The graph's ops reachable from the expression's last op become nodes,
+    // in record order which is an order of evaluation. Identical nodes are
+    // merged, muls feeding add/sub are fused, and each value is given the
+    // result buffer or a tmp slot - the result buffer (root) from the last
+    // node down through first operands read nowhere else, so nothing reads
+    // the result buffer after it is written again.
+    void compile()
+    {
+        instrs.clear(), inputs.clear(), consts.clear(), slots = 0;
+
+        if (!t.graph) // nothing recorded, ret = v
+        {
+            inputs.emplace_back(t.v);
+            LazyInstr mov{LazyCode::MOV};
+            mov.src[0] = {LazyArg::IN, 0};
+            instrs.emplace_back(mov);
+            return;
+        }
+
+        auto const& ops = *t.graph;
+        std::size_t const end = std::size_t{t.node} + 1;
+        std::vector<bool> reached(end, false);
+        reached[t.node] = true;
+        for (std::size_t i = end; i-- > 0;)
+            if (reached[i])
+                for (auto const n : {ops[i].na, ops[i].nb})
+                    if (n != LazyOp<Vec_t>::leaf)
+                        reached[n] = true;
+
+        std::vector<Node> nodes(end);
+        std::vector<std::size_t> same(end); // node i is node same[i]
+        std::map<std::tuple<LazyCode, Ref, Ref>, std::size_t> seen;
+        for (std::size_t i = 0; i < end; ++i)
+        {
+            if (!reached[i])
+                continue;
+            auto const& op = ops[i];
+            auto& node     = nodes[i];
+            auto const ref = [&](auto const n, auto const* in) {
+                return n == LazyOp<Vec_t>::leaf ? Ref{npos, in} : Ref{same[n]};
+            };
+            node.code   = codes[op.op];
+            node.src[0] = ref(op.na, op.a);
+            if (op.broadcast())
+                node.src[1] = constant(op.c);
+            else if (!op.unary())
+                node.src[1] = ref(op.nb, op.b);
+            if (op.op == 4 or op.op == 5) // c on the left
+                std::swap(node.src[0], node.src[1]);
+
+            auto key = std::make_tuple(node.code, node.src[0], node.src[1]);
+            if (node.code == LazyCode::ADD or node.code == LazyCode::MUL)
+                if (std::get<2>(key) < std::get<1>(key))
+                    std::swap(std::get<1>(key), std::get<2>(key));
+            same[i] = seen.emplace(key, i).first->second;
+        }
+        std::size_t const root = same[t.node];
+
+        nodes[root].live = true;
+        for (std::size_t i = root + 1; i-- > 0;)
+            if (nodes[i].live)
+                for (auto const& src : nodes[i].src)
+                    if (src.node != npos)
+                        ++nodes[src.node].uses, nodes[src.node].live = true;
+
+        for (auto n = root; n != npos;)
+        {
+            nodes[n].root = true;
+            auto const& a = nodes[n].src[nodes[n].src[0].c == npos ? 0 : 1];
+            n             = a.node != npos and nodes[a.node].uses == 1 ? a.node : npos;
+        }
+
+        // contraction, a mul is fused into its add/sub users when it has no
+        // other kind of user - its operands are inputs or live tmps so it can
+        // be evaluated again at each. nothing between a root mul and its single
+        // root user writes the result buffer. none without fma, as in expr.hpp
+        std::vector<std::size_t> add_uses(nodes.size(), 0);
+        for (auto const& node : nodes)
+            if (node.live and (node.code == LazyCode::ADD or node.code == LazyCode::SUB))
+                for (std::size_t const s : {0, 1})
+                    if (node.src[s].node != npos and node.src[s] != node.src[1 - s])
+                        ++add_uses[node.src[s].node];
+        auto const fusable = [&](Ref const& r) {
+            return Options::FMA and r.node != npos and nodes[r.node].code == LazyCode::MUL
+               and add_uses[r.node] == nodes[r.node].uses;
+        };
+        for (auto& node : nodes)
+        {
+            bool const add = node.code == LazyCode::ADD;
+            if (!node.live or !(add or node.code == LazyCode::SUB))
+                continue;
+            for (std::size_t const s : {1, 0})
+                if (fusable(node.src[s]))
                 {
-                    if (op.prev->a == t.v)
-                    {
-                        fns[op.op](r, r, b);
-                    }
-                    else
-                    {
-                        Span_t tspan{tmps[op.prev->t].data(), N};
-                        fns[op.op](r, r, tspan);
-                    }
+                    auto const& mul = nodes[node.src[s].node];
+                    auto const c    = node.src[1 - s];
+                    node.code       = add ? LazyCode::FMA : s ? LazyCode::FNMA : LazyCode::FMS;
+                    node.src        = {mul.src[0], mul.src[1], c};
+                    break;
                 }
-            }
-            else
+        }
+
+        auto const arg = [&](Ref const& r) -> LazyArg {
+            if (r.node != npos)
+                return nodes[r.node].root ? LazyArg{}
+                                          : LazyArg{LazyArg::TMP,
+                                                    static_cast<std::uint16_t>(nodes[r.node].slot)};
+            if (r.c != npos)
+                return {LazyArg::BCAST, static_cast<std::uint16_t>(r.c)};
+            std::size_t const idx = std::find(inputs.begin(), inputs.end(), r.in) - inputs.begin();
+            if (idx == inputs.size())
+                inputs.emplace_back(r.in);
+            return {LazyArg::IN, static_cast<std::uint16_t>(idx)};
+        };
+        // depth first from the root so each tmp is made just before it is
+        // needed, record order would keep every right hand subtree alive
+        std::vector<std::size_t> order, stack{root};
+        std::vector<bool> done(nodes.size(), false);
+        while (!stack.empty())
+        {
+            auto const n = stack.back();
+            bool ready   = true;
+            for (std::size_t s = nodes[n].operands(); s-- > 0;)
+                if (auto const& src = nodes[n].src[s]; src.node != npos and !done[src.node])
+                    stack.emplace_back(src.node), ready = false;
+            if (ready)
             {
-                if (use_tmp)
-                {
-                    Span_t tspan{tmps[tmp].data(), N};
-                    fns[op.op](tspan, a, b);
+                stack.pop_back();
+                if (!done[n])
+                    done[n] = true, order.emplace_back(n);
+            }
+        }
 
-                    op.t = tmp++;
-                }
-                else
+        for (auto const n : order)
+        {
+            auto& node = nodes[n];
+            LazyInstr instr{node.code};
+            for (std::size_t s = 0; s < node.operands(); ++s)
+                instr.src[s] = arg(node.src[s]);
+            if (!node.root)
+                node.slot = slots++;
+            instr.dst = arg(Ref{n});
+            instrs.emplace_back(instr);
+        }
+
+        reuse_slots();
+    }
+
+    Ref constant(Reg const& c)
+    {
+        std::size_t const idx = std::find(consts.begin(), consts.end(), c) - consts.begin();
+        if (idx == consts.size())
+            consts.emplace_back(c);
+        return {npos, nullptr, idx};
+    }
+
+    // one slot per tmp so far, renumber so a slot is reused after its last
+    // read - possibly as the destination of that same instruction, span ops
+    // are elementwise
+    void reuse_slots()
+    {
+        std::vector<std::size_t> last(slots, 0);
+        for (std::size_t i = 0; i < instrs.size(); ++i)
+            for (std::size_t s = 0; s < instrs[i].operands(); ++s)
+                if (instrs[i].src[s].kind == LazyArg::TMP)
+                    last[instrs[i].src[s].idx] = i;
+
+        std::vector<std::uint16_t> slot(slots), free;
+        std::uint16_t used = 0;
+        for (std::size_t i = 0; i < instrs.size(); ++i)
+        {
+            auto& instr = instrs[i];
+            for (std::size_t s = 0; s < instr.operands(); ++s)
+                if (auto& src = instr.src[s]; src.kind == LazyArg::TMP)
                 {
-                    fns[op.op](r, r, b);
+                    if (last[src.idx] == i)
+                        last[src.idx] = npos, free.emplace_back(slot[src.idx]);
+                    src.idx = slot[src.idx];
                 }
+            if (instr.dst.kind == LazyArg::TMP)
+            {
+                if (free.empty())
+                    slot[instr.dst.idx] = used++;
+                else
+                    slot[instr.dst.idx] = free.back(), free.pop_back();
+                instr.dst.idx = slot[instr.dst.idx];
             }
-        };
-
-#ifdef __cpp_lib_hardware_interference_size
-        std::size_t const cl_size = std::hardware_destructive_interference_size;
-#else
-        std::size_t constexpr cl_size = 64;
-#endif
-
-        std::size_t const batch = cl_size / sizeof(T) / N;
+        }
+        slots = used;
+    }
 
-        std::size_t i = 0;
-        for (; i < size / N; i += batch, tmp = 0)
-            for (std::size_t o = 0; o < t.operands.size(); ++o)
-                for (std::size_t j = 0; j < batch; ++j)
-                    do_avx(o, i + j);
+    void operator()(T* const ret) { (*this)(ret, seq); }
 
-        if (size % N != 0)
-            for (; i < size / N + 1; i += batch, tmp = 0)
-                for (std::size_t o = 0; o < t.operands.size(); ++o)
-                    do_avx(o, i);
+    template<typename Policy>
+    void operator()(T* const ret, Policy const& policy)
+    {
+        compile();
+        if (LazyTuning::global().enabled())
+            this->tune(ret, *t.v, policy);
+        else
+            this->use_tuned(t.v->size(), policy);
+        this->execute(ret, *t.v, policy);
     }
 
+    template<typename Op, typename Policy>
+    T fold(Op const& op, T const init, Policy const& policy)
+    {
+        compile();
+        this->use_tuned(t.v->size(), policy);
+        return Super::fold(*t.v, op, init, policy);
+    }
 
     void write_compilable(std::string const& fileout)
     {
+        compile();
+
         kul::io::Writer w{fileout};
         std::string const padding = "        ";
         std::string const header  = R"(
@@ -258,80 +995,61 @@ struct LazyEvaluator
 #include <array>
 #include <vector>
 #include <cstdint>
+#include <algorithm>
 
 template<typename E>
-using AVXVec = std::vector<E, mkn::kul::AlignedAllocator<E, Options::ALIGN()>>;
+using AVXVec = std::vector<E, mkn::kul::AlignedAllocator<E, mkn::avx::Options::ALIGN()>>;
 )";
 
         std::string const funcheader = R"(
 
-template<typename LazyVal_t, typename T>
-void exec(LazyVal_t const& t, T* const ret){
-    using Span_t            = mkn::avx::Span<T>;
-    using Span_ct           = mkn::avx::Span<T const>;
+// in[k] and c[k] as LazyEvaluator::inputs and consts
+template<typename T>
+void exec(T const* const* in, T const* const* c, T* const ret, std::size_t const size){
+    using Span_t            = mkn::avx::AsymmetricSpan<T>;
+    using Span_ct           = mkn::avx::AsymmetricSpan<T const>;
     auto constexpr static N = mkn::avx::Options::N<T>();
     static AVXVec<std::array<T, N>> tmps(n_tmps);
-    std::fill_n(tmps[0].data(), N * tmps.size(), 0);
-    auto const& ops = t.operands;
-    auto const& size = t.operands[0].a->size();
-    for (std::size_t i = 0; i < size / N; ++i)
+    for (std::size_t off = 0; off < size; off += N)
     {
-        std::size_t const off = i * N;
-        Span_t r{ret + off, N};
+        std::size_t const n = std::min<std::size_t>(N, size - off);
+        Span_t r{ret + off, n};
 )";
 
+        auto const span = [&](LazyArg const& arg) {
+            if (arg.kind == LazyArg::TMP)
+                return "Span_ct{tmps[" + std::to_string(arg.idx) + "].data(), n}";
+            if (arg.kind == LazyArg::IN)
+                return "Span_ct{in[" + std::to_string(arg.idx) + "] + off, n}";
+            if (arg.kind == LazyArg::BCAST)
+                return "Span_ct{c[" + std::to_string(arg.idx) + "], n}";
+            return std::string{"r"};
+        };
+
         std::stringstream body;
         body << "\n";
-        std::size_t tmp = 0;
-        for (std::size_t o = 0; o < t.operands.size(); ++o)
+        for (auto const& in : instrs)
         {
-            auto& op            = t.operands[o];
-            bool const use_tmp  = op.a != t.v;
-            std::string const a = "Span_ct{ops[" + std::to_string(o) + "].a->data() + off, N}";
-            std::string const b = "Span_ct{ops[" + std::to_string(o) + "].b->data() + off, N}";
-
-            if (op.prev)
-            {
-                if (use_tmp)
-                {
-                    body << padding << "Span_t{tmps[" << tmp << "].data(), N}." << fn_strs[op.op]
-                         << "(" << a << ", Span_ct{tmps[" << op.prev->t << "].data(), N});"
-                         << mkn::kul::os::EOL();
-
-                    op.t = tmp++;
-                }
-                else
-                {
-                    if (op.prev->a == t.v)
-                    {
-                        body << padding << "r." << fn_strs[op.op] << "(r, " << b << ");"
-                             << mkn::kul::os::EOL();
-                    }
-                    else
-                    {
-                        body << padding << "r." << fn_strs[op.op] << "(r, Span_ct{tmps["
-                             << op.prev->t << "].data(), N});" << mkn::kul::os::EOL();
-                    }
-                }
-            }
+            body << padding;
+            if (in.dst.kind == LazyArg::TMP)
+                body << "Span_t{tmps[" << in.dst.idx << "].data(), n}";
+            else
+                body << "r";
+            if (in.code == LazyCode::MOV)
+                body << " = " << span(in.src[0]);
             else
             {
-                if (use_tmp)
-                {
-                    body << padding << "Span_t{tmps[" << tmp << "].data(), N}." << fn_strs[op.op]
-                         << "(" << a << ", " << b << ");" << mkn::kul::os::EOL();
-                    op.t = tmp++;
-                }
-                else
-                {
-                    body << padding << "r." << fn_strs[op.op] << "(r, " << b << ");"
-                         << mkn::kul::os::EOL();
-                }
+                body << "." << fn_strs[static_cast<std::size_t>(in.code)] << "("
+                     << span(in.src[0]);
+                for (std::size_t s = 1; s < in.operands(); ++s)
+                    body << ", " << span(in.src[s]);
+                body << ")";
             }
+            body << ";" << mkn::kul::os::EOL();
         }
 
         w << header;
-        w << "\nconstexpr static std::size_t n_tmps = " << (tmp) << ";";
+        w << "\nconstexpr static std::size_t n_tmps = " << std::max<std::size_t>(1, slots) << ";";
         w << funcheader;
         w << body.str();
         w << R"(    }
@@ -340,30 +1058,259 @@ void exec(LazyVal_t const& t, T* const ret){
 )";
     }
 
+    // standalone source for the recorded expression, see jit.hpp
+    //   extern "C" void mkn_avx_kernel(T* r, T const* const* in, std::size_t size)
+    // ins receives in[], LazyEvaluator::inputs then consts, so equal structures
+    // give equal source whatever the data
+    std::string kernel_source(std::vector<T const*>& ins)
+    {
+        static_assert(std::is_same_v<T, float> or std::is_same_v<T, double>);
+        std::string const type = std::is_same_v<T, float> ? "float" : "double";
+
+        compile();
+
+        auto const name = [](LazyArg const& arg) {
+            std::stringstream ss;
+            if (arg.kind == LazyArg::TMP)
+                ss << "t" << arg.idx;
+            else if (arg.kind == LazyArg::IN)
+                ss << "in" << arg.idx << "[i]";
+            else if (arg.kind == LazyArg::BCAST)
+                ss << "c" << arg.idx << "[i % " << N << "]";
+            else
+                ss << "v";
+            return ss.str();
+        };
+
+        auto const& EOL = mkn::kul::os::EOL();
+        std::stringstream ss;
+        ss << "#include <cmath>" << EOL << "#include <cstddef>" << EOL << EOL
+           << "extern \"C\" void mkn_avx_kernel(" << type << "* r, " << type
+           << " const* const* in, std::size_t size)" << EOL << "{" << EOL;
+        for (std::size_t i = 0; i < inputs.size(); ++i)
+            ss << "    " << type << " const* in" << i << " = in[" << i << "];" << EOL;
+        for (std::size_t i = 0; i < consts.size(); ++i)
+            ss << "    " << type << " const* c" << i << " = in[" << inputs.size() + i << "];"
+               << EOL;
+        ss << "    for (std::size_t i = 0; i < size; ++i)" << EOL << "    {" << EOL << "        "
+           << type << " v;" << EOL;
+        for (std::size_t s = 0; s < slots; ++s)
+            ss << "        " << type << " t" << s << ";" << EOL;
+        for (auto const& in : instrs)
+        {
+            auto const a = name(in.src[0]), b = name(in.src[1]), c = name(in.src[2]);
+            ss << "        " << name(in.dst) << " = ";
+            switch (in.code)
+            {
+                case LazyCode::FMA: ss << a << " * " << b << " + " << c; break;
+                case LazyCode::FMS: ss << a << " * " << b << " - " << c; break;
+                case LazyCode::FNMA: ss << c << " - " << a << " * " << b; break;
+                case LazyCode::MIN: ss << b << " < " << a << " ? " << b << " : " << a; break;
+                case LazyCode::MAX: ss << a << " < " << b << " ? " << b << " : " << a; break;
+                case LazyCode::MOV: ss << a; break;
+                case LazyCode::SQRT: ss << "std::sqrt(" << a << ")"; break;
+                case LazyCode::ABS: ss << "std::abs(" << a << ")"; break;
+                case LazyCode::NEG: ss << "-" << a; break;
+                case LazyCode::EXP: ss << "std::exp(" << a << ")"; break;
+                default: ss << a << " " << op_strs[static_cast<std::size_t>(in.code)] << " " << b;
+            }
+            ss << ";" << EOL;
+        }
+        ss << "        r[i] = v;" << EOL << "    }" << EOL << "}" << EOL;
+
+        ins.clear();
+        for (auto const* v : inputs)
+            ins.emplace_back(v->data());
+        for (auto const& c : consts)
+            ins.emplace_back(c.data());
+        return ss.str();
+    }
+
     LazyVal_t& t;
-    std::vector<std::function<void(Span_t&, Span_ct const&, Span_ct const&)>> fns{__add__, __sub__,
-                                                                                  __mul__, __div__};
-    std::vector<std::string> fn_strs{"add", "sub", "mul", "div"};
+    std::vector<std::string> fn_strs{"add", "sub", "mul", "div", "fma",  "fms", "fnma",
+                                     "min", "max", "",    "sqrt", "abs", "neg",  "exp"};
+    std::vector<std::string> op_strs{"+", "-", "*", "/"};
+};
 
-    template<typename E>
-    using AVXVec = std::vector<E, mkn::kul::AlignedAllocator<E, Options::ALIGN()>>;
-    static inline thread_local AVXVec<std::array<T, N>> tmps{};
+
+// An expression compiled once for repeated evaluation
+//
+//   auto [l0, l1] = mkn::avx::lazy(a0, a1);
+//   mkn::avx::LazyPlan plan{l0 * l1 + 2.0};
+//   plan(r);               // r = a0 * a1 + 2
+//   plan.bind(a0, b0)(r);  // r = b0 * a1 + 2
+//
+// The expression is compiled on construction and may then be dropped. Vectors
+// are bound by address and calls do no setup, or allocation after the first
+// per thread. The block is the one tuned for the policy given on construction,
+// seq by default
+//   mkn::avx::LazyPlan pplan{l0 * l1 + 2.0, mkn::avx::par};
+//   pplan(r, mkn::avx::par);
+template<typename Vec>
+struct LazyPlan : public LazyProgram<Vec>
+{
+    using Super = LazyProgram<Vec>;
+    using typename Super::T;
+    using typename Super::Vec_t;
+
+    template<typename Policy = Sequential>
+    LazyPlan(LazyVal<Vec> lazy, Policy const& policy = seq)
+        : Super{compiled(lazy)}
+        , v{lazy.v}
+    {
+        this->use_tuned(size(), policy);
+    }
+
+    // vectors per block, 0 for the default
+    LazyPlan& block(std::size_t const vectors)
+    {
+        this->block_size = vectors;
+        return *this;
+    }
+    std::size_t block() const { return this->batch(); }
+
+    // times a few block sizes into ret and keeps the fastest, for this plan
+    // and every later one of the same shape - see LazyProgram::tune
+    //   LazyPlan plan{l0 * l1 + l2};
+    //   plan.tune(r)(r);
+    template<typename Policy = Sequential>
+    LazyPlan& tune(Vec_t& ret, Policy const& policy = seq)
+    {
+        assert(ret.size() >= size());
+        Super::tune(ret.data(), *v, policy);
+        return *this;
+    }
+
+    // every read of from now reads to, which must have at least size() elements
+    LazyPlan& bind(Vec_t const& from, Vec_t const& to)
+    {
+        std::replace(this->inputs.begin(), this->inputs.end(), &from, &to);
+        if (v == &from)
+            v = &to;
+        return *this;
+    }
+
+    template<typename Policy = Sequential>
+    void operator()(T* const ret, Policy const& policy = seq) const
+    {
+        this->execute(ret, *v, policy);
+    }
+    template<typename Policy = Sequential>
+    void operator()(Vec_t& ret, Policy const& policy = seq) const
+    {
+        assert(ret.size() >= size());
+        this->execute(ret.data(), *v, policy);
+    }
+
+    auto size() const { return v->size(); }
+
+private:
+    static Super compiled(LazyVal<Vec_t>& lazy)
+    {
+        LazyEvaluator<LazyVal<Vec_t>> evaluator{lazy};
+        evaluator.compile();
+        return evaluator;
+    }
+
+    Vec_t const* v; // result operand
 };
 
-template<typename T>
-auto eval(LazyVal<T>& v, bool /*in_place*/ = false)
+// r = expr in a new vector the size of the result operand
+//   auto r = eval(l0 * l1 + l2);
+//   auto q = eval(l0 * l1 + l2, mkn::avx::par);
+template<typename T, typename Policy = Sequential>
+auto eval(LazyVal<T>& v, Policy const& policy = seq)
 {
-    auto ret = v();
-    LazyEvaluator<LazyVal<T>>{v}(ret.data());
+    T ret(v().size());
+    LazyEvaluator<LazyVal<T>>{v}(ret.data(), policy);
     return ret;
 }
-template<typename T>
-auto eval(LazyVal<T>&& v, bool /*in_place*/ = false)
+template<typename T, typename Policy = Sequential>
+auto eval(LazyVal<T>&& v, Policy const& policy = seq)
 {
-    auto ret = v();
-    LazyEvaluator<LazyVal<T>>{v}(ret.data());
+    return eval(v, policy);
+}
+
+// as eval, into a vector drawn from arena - see arena.hpp
+//   auto r = eval(l0 * l1 + l2, arena);
+template<typename T, typename Policy = Sequential>
+auto eval(LazyVal<T>& v, Arena& arena, Policy const& policy = seq)
+{
+    using E = typename T::value_type;
+    Vector<E, ArenaAllocator<E>> ret(v().size(), ArenaAllocator<E>{arena});
+    LazyEvaluator<LazyVal<T>>{v}(ret.data(), policy);
     return ret;
 }
+template<typename T, typename Policy = Sequential>
+auto eval(LazyVal<T>&& v, Arena& arena, Policy const& policy = seq)
+{
+    return eval(v, arena, policy);
+}
+
+// dst = expr without allocating, dst may be any of its operands
+//   eval_into(a1, l0 * l1 + l1); // a1 = a0 * a1 + a1
+template<typename T, typename Policy = Sequential>
+T& eval_into(T& dst, LazyVal<T>& v, Policy const& policy = seq)
+{
+    assert(dst.size() >= v().size());
+    LazyEvaluator<LazyVal<T>>{v}(dst.data(), policy);
+    return dst;
+}
+template<typename T, typename Policy = Sequential>
+T& eval_into(T& dst, LazyVal<T>&& v, Policy const& policy = seq)
+{
+    return eval_into(dst, v, policy);
+}
+
+// the result operand = expr
+//   eval_in_place(l0 * l1 + l2); // a0 = a0 * a1 + a2
+template<typename T, typename Policy = Sequential>
+T& eval_in_place(LazyVal<T>& v, Policy const& policy = seq)
+{
+    return eval_into(v(), v, policy);
+}
+template<typename T, typename Policy = Sequential>
+T& eval_in_place(LazyVal<T>&& v, Policy const& policy = seq)
+{
+    return eval_in_place(v, policy);
+}
+
+// terminal reductions, folded in registers as the expression is evaluated
+//   auto const d = sum(l0 * l1);
+//   auto const e = max(abs(l0 - l1), mkn::avx::par);
+template<typename T, typename Policy = Sequential, std::enable_if_t<is_policy_v<Policy>, bool> = 0>
+auto sum(LazyVal<T> v, Policy const& policy = seq)
+{
+    using E           = typename T::value_type;
+    auto constexpr op = [](auto const& a, auto const& b) { return a + b; };
+    return LazyEvaluator<LazyVal<T>>{v}.fold(op, E{0}, policy);
+}
+
+template<typename T, typename Policy = Sequential, std::enable_if_t<is_policy_v<Policy>, bool> = 0>
+auto min(LazyVal<T> v, Policy const& policy = seq)
+{
+    using E           = typename T::value_type;
+    auto constexpr op = [](auto const& a, auto const& b) {
+        if constexpr (std::is_arithmetic_v<std::decay_t<decltype(a)>>)
+            return b < a ? b : a;
+        else
+            return mkn::avx::min(a, b);
+    };
+    return LazyEvaluator<LazyVal<T>>{v}.fold(op, std::numeric_limits<E>::max(), policy);
+}
+
+template<typename T, typename Policy = Sequential, std::enable_if_t<is_policy_v<Policy>, bool> = 0>
+auto max(LazyVal<T> v, Policy const& policy = seq)
+{
+    using E           = typename T::value_type;
+    auto constexpr op = [](auto const& a, auto const& b) {
+        if constexpr (std::is_arithmetic_v<std::decay_t<decltype(a)>>)
+            return a < b ? b : a;
+        else
+            return mkn::avx::max(a, b);
+    };
+    return LazyEvaluator<LazyVal<T>>{v}.fold(op, std::numeric_limits<E>::lowest(), policy);
+}
 
 template<typename... T>
 auto lazy(T&... v)
@@ -371,6 +1318,14 @@ auto lazy(T&... v)
     return std::make_tuple(LazyVal<T>{v}...);
 }
 
+// as lazy, with expression graphs over these drawn from arena - see arena.hpp
+//   auto [l0, l1] = mkn::avx::lazy(arena, a0, a1);
+template<typename... T>
+auto lazy(Arena& arena, T&... v)
+{
+    return std::make_tuple(LazyVal<T>{v, &arena}...);
+}
+
 } // namespace mkn::avx
 
 #endif /* _MKN_AVX_LAZY_HPP_ */
@@ -0,0 +1,477 @@
+/**
+Copyright (c) 2024, Philip Deegan.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+    * Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the following disclaimer
+in the documentation and/or other materials provided with the
+distribution.
+    * Neither the name of Philip Deegan nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef _MKN_AVX_MATH_HPP_
+#define _MKN_AVX_MATH_HPP_
+
+#include "mkn/avx/def.hpp"
+#include "mkn/avx/types.hpp"
+
+#include <cmath>
+#include <array>
+#include <limits>
+#include <cstdint>
+
+// Vectorized exp, log, sqrt, rsqrt, sin, cos, pow, abs, neg on Type<T, N>
+//
+//   auto const y = mkn::avx::exp(mkn::avx::unaligned_load<double, 4>(p));
+//   r.exp(a); // Span/AsymmetricSpan
+//
+// Worst case error against a long double reference, measured by test_math over
+// the ranges below, in units in the last place of T. With FMA - without, exp is
+// within 1.5 and float sin/cos within 3
+//
+//   fn     | valid range                        | float | double
+//   -------+------------------------------------+-------+-------
+//   sqrt   | x >= 0                             | 0.5   | 0.5
+//   rsqrt  | x > 0                              | 1.5   | 1.5
+//   exp    | all x                              | 1     | 1
+//   log    | x > 0, subnormals included         | 1     | 1
+//   sin    | |x| < 8192 (float), 1e6 (double)   | 2     | 2
+//   cos    | |x| < 8192 (float), 1e6 (double)   | 2     | 2
+//   pow    | x > 0                              | 1 + 2 |y log(x)|
+//
+// beyond the sin/cos range the Cody-Waite reduction loses bits, there is no
+// Payne-Hanek fallback. pow is exp(y * log(x)) so the rounding error of the
+// log is scaled by y, use std::pow where that matters.
+//
+// exp overflows to inf and underflows through the subnormals to 0, log(0) is
+// -inf, log(x < 0) NaN, pow(x, 0) is 1, NaN propagates otherwise. Without
+// SIMD (N == 1) everything forwards to std::
+//
+// abs and neg are exact, they only change the sign bit.
+//
+// Reductions are Cody-Waite with the constants split in two or three parts,
+// the polynomials are truncated Taylor series in Horner form, long enough that
+// the truncation error is below half an ulp over the reduced range.
+
+namespace mkn::avx::inline MKN_AVX_TIER
+{
+namespace detail
+{
+    // exponent field tricks, per width as they need the integer ops
+    template<typename T, std::size_t SIZE>
+    struct Bits_;
+
+    template<>
+    struct Bits_<double, 2>
+    {
+        // 2^n for integral n in [-1022, 1023]
+        auto const static inline pow2n = [](auto const& n) {
+            auto const biased = _mm_add_pd(n, _mm_set1_pd(0x1p52 + 1023));
+            return _mm_castsi128_pd(_mm_slli_epi64(_mm_castpd_si128(biased), 52));
+        };
+        // x == mantissa(x) * 2^exponent(x), mantissa in [0.5, 1) - positive normal x
+        auto const static inline exponent = [](auto const& x) {
+            auto const e = _mm_srli_epi64(_mm_castpd_si128(x), 52);
+            auto const f = _mm_or_si128(e, _mm_castpd_si128(_mm_set1_pd(0x1p52)));
+            return _mm_sub_pd(_mm_castsi128_pd(f), _mm_set1_pd(0x1p52 + 1022));
+        };
+        auto const static inline mantissa = [](auto const& x) {
+            auto const m = _mm_and_si128(_mm_castpd_si128(x), _mm_set1_epi64x(0xFFFFFFFFFFFFF));
+            return _mm_castsi128_pd(_mm_or_si128(m, _mm_castpd_si128(_mm_set1_pd(.5))));
+        };
+    };
+
+    template<>
+    struct Bits_<double, 4>
+    {
+        auto const static inline pow2n = [](auto const& n) {
+            auto const biased = _mm256_add_pd(n, _mm256_set1_pd(0x1p52 + 1023));
+            return _mm256_castsi256_pd(_mm256_slli_epi64(_mm256_castpd_si256(biased), 52));
+        };
+        auto const static inline exponent = [](auto const& x) {
+            auto const e = _mm256_srli_epi64(_mm256_castpd_si256(x), 52);
+            auto const f = _mm256_or_si256(e, _mm256_castpd_si256(_mm256_set1_pd(0x1p52)));
+            return _mm256_sub_pd(_mm256_castsi256_pd(f), _mm256_set1_pd(0x1p52 + 1022));
+        };
+        auto const static inline mantissa = [](auto const& x) {
+            auto const m
+                = _mm256_and_si256(_mm256_castpd_si256(x), _mm256_set1_epi64x(0xFFFFFFFFFFFFF));
+            return _mm256_castsi256_pd(_mm256_or_si256(m, _mm256_castpd_si256(_mm256_set1_pd(.5))));
+        };
+    };
+
+    template<>
+    struct Bits_<double, 8>
+    {
+        auto const static inline pow2n = [](auto const& n) {
+            auto const biased = _mm512_add_pd(n, _mm512_set1_pd(0x1p52 + 1023));
+            return _mm512_castsi512_pd(_mm512_slli_epi64(_mm512_castpd_si512(biased), 52));
+        };
+        auto const static inline exponent = [](auto const& x) {
+            auto const e = _mm512_srli_epi64(_mm512_castpd_si512(x), 52);
+            auto const f = _mm512_or_si512(e, _mm512_castpd_si512(_mm512_set1_pd(0x1p52)));
+            return _mm512_sub_pd(_mm512_castsi512_pd(f), _mm512_set1_pd(0x1p52 + 1022));
+        };
+        auto const static inline mantissa = [](auto const& x) {
+            auto const m
+                = _mm512_and_si512(_mm512_castpd_si512(x), _mm512_set1_epi64(0xFFFFFFFFFFFFF));
+            return _mm512_castsi512_pd(_mm512_or_si512(m, _mm512_castpd_si512(_mm512_set1_pd(.5))));
+        };
+    };
+
+    template<>
+    struct Bits_<float, 4>
+    {
+        // 2^n for integral n in [-126, 127]
+        auto const static inline pow2n = [](auto const& n) {
+            auto const biased = _mm_add_ps(n, _mm_set1_ps(0x1p23f + 127));
+            return _mm_castsi128_ps(_mm_slli_epi32(_mm_castps_si128(biased), 23));
+        };
+        auto const static inline exponent = [](auto const& x) {
+            auto const e = _mm_srli_epi32(_mm_castps_si128(x), 23);
+            auto const f = _mm_or_si128(e, _mm_castps_si128(_mm_set1_ps(0x1p23f)));
+            return _mm_sub_ps(_mm_castsi128_ps(f), _mm_set1_ps(0x1p23f + 126));
+        };
+        auto const static inline mantissa = [](auto const& x) {
+            auto const m = _mm_and_si128(_mm_castps_si128(x), _mm_set1_epi32(0x7FFFFF));
+            return _mm_castsi128_ps(_mm_or_si128(m, _mm_castps_si128(_mm_set1_ps(.5f))));
+        };
+    };
+
+    template<>
+    struct Bits_<float, 8>
+    {
+        auto const static inline pow2n = [](auto const& n) {
+            auto const biased = _mm256_add_ps(n, _mm256_set1_ps(0x1p23f + 127));
+            return _mm256_castsi256_ps(_mm256_slli_epi32(_mm256_castps_si256(biased), 23));
+        };
+        auto const static inline exponent = [](auto const& x) {
+            auto const e = _mm256_srli_epi32(_mm256_castps_si256(x), 23);
+            auto const f = _mm256_or_si256(e, _mm256_castps_si256(_mm256_set1_ps(0x1p23f)));
+            return _mm256_sub_ps(_mm256_castsi256_ps(f), _mm256_set1_ps(0x1p23f + 126));
+        };
+        auto const static inline mantissa = [](auto const& x) {
+            auto const m = _mm256_and_si256(_mm256_castps_si256(x), _mm256_set1_epi32(0x7FFFFF));
+            auto const half = _mm256_castps_si256(_mm256_set1_ps(.5f));
+            return _mm256_castsi256_ps(_mm256_or_si256(m, half));
+        };
+    };
+
+    template<>
+    struct Bits_<float, 16>
+    {
+        auto const static inline pow2n = [](auto const& n) {
+            auto const biased = _mm512_add_ps(n, _mm512_set1_ps(0x1p23f + 127));
+            return _mm512_castsi512_ps(_mm512_slli_epi32(_mm512_castps_si512(biased), 23));
+        };
+        auto const static inline exponent = [](auto const& x) {
+            auto const e = _mm512_srli_epi32(_mm512_castps_si512(x), 23);
+            auto const f = _mm512_or_si512(e, _mm512_castps_si512(_mm512_set1_ps(0x1p23f)));
+            return _mm512_sub_ps(_mm512_castsi512_ps(f), _mm512_set1_ps(0x1p23f + 126));
+        };
+        auto const static inline mantissa = [](auto const& x) {
+            auto const m = _mm512_and_si512(_mm512_castps_si512(x), _mm512_set1_epi32(0x7FFFFF));
+            auto const half = _mm512_castps_si512(_mm512_set1_ps(.5f));
+            return _mm512_castsi512_ps(_mm512_or_si512(m, half));
+        };
+    };
+
+
+    // +-1 / (step * k + offset)! for k in [first, first + K), alternating from + at k = 0
+    template<typename T, std::size_t K>
+    std::array<T, K> constexpr series(std::size_t const step, std::size_t const offset,
+                                      bool const alt, std::size_t const first = 0)
+    {
+        std::array<T, K> c{};
+        long double fact = 1;
+        std::size_t n    = 1;
+        for (std::size_t k = first; k < first + K; ++k)
+        {
+            for (; n < step * k + offset; ++n)
+                fact *= n + 1;
+            c[k - first] = static_cast<T>((alt and k % 2 ? -1 : 1) / fact);
+        }
+        return c;
+    }
+
+    // 2 / (2k + 1) for k in [1, K], log(m) = 2s + s * z * P(z), z = s^2, s = (m - 1) / (m + 1)
+    template<typename T, std::size_t K>
+    std::array<T, K> constexpr atanh_series()
+    {
+        std::array<T, K> c{};
+        for (std::size_t k = 1; k <= K; ++k)
+            c[k - 1] = static_cast<T>(2.0L / (2 * k + 1));
+        return c;
+    }
+
+    template<typename T>
+    struct Consts;
+
+    template<>
+    struct Consts<double>
+    {
+        double static constexpr exp_lo = -746, exp_hi = 710; // past under/overflow
+        double static constexpr log2e  = 1.44269504088896340736;
+        double static constexpr ln2_hi = 6.93147180369123816490e-01; // low bits clear
+        double static constexpr ln2_lo = 1.90821492927058770002e-10;
+
+        double static constexpr min_normal = 0x1p-1022, subnormal_scale = 0x1p54, subnormal_e = 54;
+        double static constexpr sqrt_half  = 0.70710678118654752440;
+
+        double static constexpr two_over_pi = 0.63661977236758134308;
+        double static constexpr pio2_1      = 1.57079625129699707031e+00;
+        double static constexpr pio2_2      = 7.54978941586159635335e-08;
+        double static constexpr pio2_3      = 5.39030285815811905290e-15;
+
+        auto static constexpr exp_poly = series<double, 14>(1, 0, false);   // |r| <= ln2 / 2
+        auto static constexpr log_poly = atanh_series<double, 10>();        // |s| <= 0.172
+        auto static constexpr sin_poly = series<double, 7>(2, 1, true, 1); // |r| <= pi / 4
+        auto static constexpr cos_poly = series<double, 7>(2, 0, true, 2);
+    };
+
+    template<>
+    struct Consts<float>
+    {
+        float static constexpr exp_lo = -104, exp_hi = 89;
+        float static constexpr log2e  = 1.44269504088896340736f;
+        float static constexpr ln2_hi = 0.693359375f;
+        float static constexpr ln2_lo = -2.12194440e-4f;
+
+        float static constexpr min_normal = 0x1p-126f, subnormal_scale = 0x1p25f, subnormal_e = 25;
+        float static constexpr sqrt_half  = 0.70710678118654752440f;
+
+        float static constexpr two_over_pi = 0.63661977236758134308f;
+        float static constexpr pio2_1      = 1.5703125f;
+        float static constexpr pio2_2      = 4.837512969970703125e-4f;
+        float static constexpr pio2_3      = 7.54978995489188216e-8f;
+
+        auto static constexpr exp_poly = series<float, 8>(1, 0, false);
+        auto static constexpr log_poly = atanh_series<float, 5>();
+        auto static constexpr sin_poly = series<float, 4>(2, 1, true, 1);
+        auto static constexpr cos_poly = series<float, 4>(2, 0, true, 2);
+    };
+
+
+    template<typename T, std::size_t SIZE>
+    Type<T, SIZE> inline muladd(Type<T, SIZE> const& a, Type<T, SIZE> const& b,
+                                Type<T, SIZE> const& c) noexcept
+    {
+        if constexpr (Options::FMA)
+            return fma(a, b, c);
+        else
+            return a * b + c;
+    }
+
+    // c[0] + x * (c[1] + x * (... + x * c[K - 1]))
+    template<typename T, std::size_t SIZE, std::size_t K>
+    Type<T, SIZE> inline horner(Type<T, SIZE> const& x, std::array<T, K> const& c) noexcept
+    {
+        Type<T, SIZE> p{Type_<T, SIZE>::set_v(c[K - 1])};
+        for (std::size_t k = K - 1; k-- > 0;)
+            p = muladd(p, x, Type<T, SIZE>{Type_<T, SIZE>::set_v(c[k])});
+        return p;
+    }
+
+    template<typename T, std::size_t SIZE>
+    Type<T, SIZE> inline select(auto const& m, Type<T, SIZE> const& a,
+                                Type<T, SIZE> const& b) noexcept
+    {
+        return {Type_<T, SIZE>::select(m, a(), b())};
+    }
+
+    // sin(x) for quadrant offset 0, cos(x) for 1
+    template<typename T, std::size_t SIZE>
+    Type<T, SIZE> inline sincos(Type<T, SIZE> const& x, T const offset) noexcept
+    {
+        using C      = Consts<T>;
+        using Impl   = Type_<T, SIZE>;
+        using V      = Type<T, SIZE>;
+        auto const k = [](T const c) { return V{Impl::set_v(c)}; };
+
+        // r = x - j * pi / 2, |r| <= pi / 4
+        V const j{Impl::round((x * k(C::two_over_pi))())};
+        auto r = muladd(j, k(-C::pio2_1), x);
+        r      = muladd(j, k(-C::pio2_2), r);
+        r      = muladd(j, k(-C::pio2_3), r);
+
+        // sin = r + r^3 * S(z), cos = 1 - z / 2 + z^2 * C(z) with the 1 - z / 2
+        // rounding error carried
+        auto const z  = r * r;
+        auto const s  = muladd(r * z, horner(z, C::sin_poly), r);
+        auto const hz = z * k(.5);
+        auto const w  = k(1) - hz;
+        auto const c  = w + (((k(1) - w) - hz) + z * z * horner(z, C::cos_poly));
+
+        // quadrant q: odd takes cos, 2 and 3 are negated
+        auto const q       = j + k(offset);
+        auto const half    = q * k(.5);
+        auto const quarter = q * k(.25);
+        auto const v       = select(Impl::neq(Impl::floor(half()), half()), c, s);
+        auto const frac    = quarter - V{Impl::floor(quarter())};
+        return select(Impl::lt(frac(), k(.5)()), v, V{Impl::bit_xor(v(), k(-0.)())});
+    }
+
+} // namespace detail
+
+
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline sqrt(Type<T, SIZE> const& x) noexcept
+{
+    if constexpr (SIZE == 1)
+        return {std::sqrt(x())};
+    else
+        return {Type_<T, SIZE>::sqrt(x())};
+}
+
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline rsqrt(Type<T, SIZE> const& x) noexcept
+{
+    if constexpr (SIZE == 1)
+        return {1 / std::sqrt(x())};
+    else
+        return Type<T, SIZE>{Type_<T, SIZE>::set_v(1)} / sqrt(x);
+}
+
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline abs(Type<T, SIZE> const& x) noexcept
+{
+    if constexpr (SIZE == 1)
+        return {std::abs(x())};
+    else
+    {
+        using Impl      = Type_<T, SIZE>;
+        auto const sign = Impl::bit_and(x(), Impl::set_v(T{-0.}));
+        return {Impl::bit_xor(x(), sign)};
+    }
+}
+
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline neg(Type<T, SIZE> const& x) noexcept
+{
+    if constexpr (SIZE == 1)
+        return {-x()};
+    else
+        return {Type_<T, SIZE>::bit_xor(x(), Type_<T, SIZE>::set_v(T{-0.}))};
+}
+
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline exp(Type<T, SIZE> const& x) noexcept
+{
+    if constexpr (SIZE == 1)
+        return {std::exp(x())};
+    else
+    {
+        using namespace detail;
+        using C      = Consts<T>;
+        using Impl   = Type_<T, SIZE>;
+        using V      = Type<T, SIZE>;
+        auto const k = [](T const c) { return V{Impl::set_v(c)}; };
+
+        // max/min return their second operand if either is NaN, so NaN survives
+        auto const xc = min(k(C::exp_hi), max(k(C::exp_lo), x));
+
+        // x = n * ln2 + r, 2^n applied in two halves so each stays a normal
+        V const n{Impl::round((xc * k(C::log2e))())};
+        auto const r = muladd(n, k(-C::ln2_lo), muladd(n, k(-C::ln2_hi), xc));
+        V const h{Impl::round((n * k(.5))())};
+
+        return horner(r, C::exp_poly) * V{Bits_<T, SIZE>::pow2n((n - h)())}
+               * V{Bits_<T, SIZE>::pow2n(h())};
+    }
+}
+
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline log(Type<T, SIZE> const& x) noexcept
+{
+    if constexpr (SIZE == 1)
+        return {std::log(x())};
+    else
+    {
+        using namespace detail;
+        using C      = Consts<T>;
+        using Impl   = Type_<T, SIZE>;
+        using V      = Type<T, SIZE>;
+        using Bits   = Bits_<T, SIZE>;
+        auto const k = [](T const c) { return V{Impl::set_v(c)}; };
+
+        // subnormals are scaled into the normal range first
+        auto const tiny = Impl::lt(x(), k(C::min_normal)());
+        auto const xs   = select(tiny, x * k(C::subnormal_scale), x);
+
+        // x = m * 2^e, m in [sqrt(0.5), sqrt(2))
+        V e{Bits::exponent(xs())};
+        V m{Bits::mantissa(xs())};
+        e                = e - select(tiny, k(C::subnormal_e), k(0));
+        auto const small = Impl::lt(m(), k(C::sqrt_half)());
+        m                = select(small, m + m, m);
+        e                = select(small, e - k(1), e);
+
+        // log(1 + f) = f - (f^2 / 2 - s * (f^2 / 2 + R)), f exact, see fdlibm
+        auto const f    = m - k(1);
+        auto const s    = f / (m + k(1));
+        auto const z    = s * s;
+        auto const hfsq = f * f * k(.5);
+        auto const t    = muladd(s, hfsq + z * horner(z, C::log_poly), e * k(C::ln2_lo));
+        auto const r    = muladd(e, k(C::ln2_hi), f - (hfsq - t));
+
+        auto const inf = std::numeric_limits<T>::infinity();
+        auto ret       = select(Impl::eq(x(), k(inf)()), k(inf), r);
+        ret            = select(Impl::eq(x(), k(0)()), k(-inf), ret);
+        ret            = select(Impl::lt(x(), k(0)()), k(std::numeric_limits<T>::quiet_NaN()), ret);
+        return select(Impl::neq(x(), x()), x, ret);
+    }
+}
+
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline sin(Type<T, SIZE> const& x) noexcept
+{
+    if constexpr (SIZE == 1)
+        return {std::sin(x())};
+    else
+        return detail::sincos(x, T{0});
+}
+
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline cos(Type<T, SIZE> const& x) noexcept
+{
+    if constexpr (SIZE == 1)
+        return {std::cos(x())};
+    else
+        return detail::sincos(x, T{1});
+}
+
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline pow(Type<T, SIZE> const& x, Type<T, SIZE> const& y) noexcept
+{
+    if constexpr (SIZE == 1)
+        return {std::pow(x(), y())};
+    else
+    {
+        using Impl   = Type_<T, SIZE>;
+        auto const k = [](T const c) { return Type<T, SIZE>{Impl::set_v(c)}; };
+        return detail::select(Impl::eq(y(), k(0)()), k(1), exp(y * log(x)));
+    }
+}
+
+} /* namespace mkn::avx */
+
+#endif /* _MKN_AVX_MATH_HPP_ */
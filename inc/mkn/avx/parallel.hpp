@@ -0,0 +1,340 @@
+/**
+Copyright (c) 2024, Philip Deegan.
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are
+met:
+
+    * Redistributions of source code must retain the above copyright
+notice, this list of conditions and the following disclaimer.
+    * Redistributions in binary form must reproduce the above
+copyright notice, this list of conditions and the following disclaimer
+in the documentation and/or other materials provided with the
+distribution.
+    * Neither the name of Philip Deegan nor the names of its
+contributors may be used to endorse or promote products derived from
+this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+"AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+#ifndef _MKN_AVX_PARALLEL_HPP_
+#define _MKN_AVX_PARALLEL_HPP_
+
+#include "mkn/avx/def.hpp"
+
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <utility>
+#include <algorithm>
+#include <type_traits>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <pthread.h>
+#endif
+
+// Execution policies for Span ops
+//
+//   a.add(b, c, mkn::avx::par);                 // global pool, all threads
+//   a.add(a, b, mkn::avx::par.with(8));         // in place, at most 8 threads
+//
+//   mkn::avx::Partition p;
+//   a.fma(b, c, d, mkn::avx::par.report_to(p)); // p holds the ranges used
+//
+// Work is split in whole batches with every boundary on a cache line, so no
+// two threads write the same line.
+
+namespace mkn::avx::inline MKN_AVX_TIER
+{
+inline constexpr std::size_t cache_line = 64;
+
+struct Partition
+{
+    std::size_t batches = 0; // total
+    std::size_t chunk   = 0; // batches per thread, a whole number of cache lines
+    std::vector<std::pair<std::size_t, std::size_t>> ranges{}; // [begin, end) per thread
+
+    auto threads() const noexcept { return ranges.size(); }
+};
+
+// addr is the start of the written span, boundaries are placed where
+// addr + batch * batch_bytes is a multiple of cache_line.
+// threads are reduced so each gets at least min_bytes.
+inline Partition partition(std::size_t const batches, std::size_t const batch_bytes,
+                           std::size_t threads, void const* const addr = nullptr,
+                           std::size_t const min_bytes = 0)
+{
+    Partition p{batches};
+    if (batches == 0)
+        return p;
+
+    if (min_bytes > 0)
+        threads = std::min(threads, std::max<std::size_t>(1, batches * batch_bytes / min_bytes));
+    threads = std::max<std::size_t>(1, threads);
+
+    std::size_t const per_line = std::max<std::size_t>(1, cache_line / batch_bytes);
+    std::size_t const mis      = reinterpret_cast<std::uintptr_t>(addr) % cache_line;
+    std::size_t const head     = std::min(batches, (cache_line - mis) % cache_line / batch_bytes);
+    std::size_t const lines    = (batches - head + per_line - 1) / per_line;
+    p.chunk                    = (lines + threads - 1) / threads * per_line;
+
+    std::size_t begin = 0;
+    for (std::size_t t = 1; begin < batches; ++t)
+    {
+        std::size_t const end = std::min(batches, head + t * p.chunk);
+        p.ranges.emplace_back(begin, end);
+        begin = end;
+    }
+    return p;
+}
+
+
+// fork/join pool - the calling thread runs task 0, workers persist between
+// runs and are pinned one per allowed cpu on linux
+class ThreadPool
+{
+public:
+    explicit ThreadPool(std::size_t const threads = std::thread::hardware_concurrency(),
+                        bool const pin = true)
+    {
+        auto const n   = std::max<std::size_t>(1, threads);
+        auto const cpu = cpus();
+        workers.reserve(n - 1);
+        for (std::size_t w = 1; w < n; ++w)
+        {
+            workers.emplace_back([this, w] { work(w); });
+            if (pin and cpu.size() > 1)
+                this->pin(workers.back(), cpu[w % cpu.size()]);
+        }
+    }
+
+    ~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            stop = true;
+        }
+        cv.notify_all();
+        for (auto& worker : workers)
+            worker.join();
+    }
+
+    ThreadPool(ThreadPool const&)            = delete;
+    ThreadPool& operator=(ThreadPool const&) = delete;
+
+    std::size_t size() const noexcept { return workers.size() + 1; }
+
+    // fn(t) for t in [0, tasks), blocks until all complete.
+    // tasks beyond size() and nested calls from a task run on the caller.
+    // the first exception from any task is rethrown once every worker is done
+    void run(std::size_t const tasks, std::function<void(std::size_t)> const& fn)
+    {
+        if (tasks == 0)
+            return;
+        if (tasks == 1 or inside or workers.empty())
+        {
+            for (std::size_t t = 0; t < tasks; ++t)
+                fn(t);
+            return;
+        }
+
+        std::lock_guard<std::mutex> serial{run_mutex};
+        std::size_t const spread = std::min(tasks, size());
+        {
+            std::lock_guard<std::mutex> lock{mutex};
+            task    = &fn;
+            n_tasks = spread;
+            pending = spread - 1;
+            ++generation;
+        }
+        cv.notify_all();
+
+        {
+            Join const join{*this};
+            try
+            {
+                fn(0);
+                for (std::size_t t = spread; t < tasks; ++t)
+                    fn(t);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock{mutex};
+                if (!error)
+                    error = std::current_exception();
+            }
+        }
+        if (auto const e = std::exchange(error, nullptr))
+            std::rethrow_exception(e);
+    }
+
+    static ThreadPool& global()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+private:
+    // the caller's share of a run, waits for the workers however it is left
+    struct Join
+    {
+        explicit Join(ThreadPool& p) noexcept
+            : pool{p}
+        {
+            inside = true;
+        }
+        ~Join()
+        {
+            inside = false;
+            std::unique_lock<std::mutex> lock{pool.mutex};
+            pool.done.wait(lock, [&] { return pool.pending == 0; });
+            pool.task = nullptr;
+        }
+
+        ThreadPool& pool;
+    };
+
+    void work(std::size_t const w)
+    {
+        inside              = true;
+        std::size_t current = 0;
+        while (true)
+        {
+            std::unique_lock<std::mutex> lock{mutex};
+            cv.wait(lock, [&] { return stop or generation != current; });
+            if (stop)
+                return;
+            current = generation;
+            if (w >= n_tasks)
+                continue;
+            auto const* fn = task;
+            lock.unlock();
+
+            std::exception_ptr e;
+            try
+            {
+                (*fn)(w);
+            }
+            catch (...)
+            {
+                e = std::current_exception();
+            }
+
+            lock.lock();
+            if (e and !error)
+                error = e;
+            if (--pending == 0)
+                done.notify_one();
+        }
+    }
+
+    static std::vector<std::size_t> cpus()
+    {
+        std::vector<std::size_t> ret;
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        if (sched_getaffinity(0, sizeof(set), &set) == 0)
+            for (std::size_t c = 0; c < CPU_SETSIZE; ++c)
+                if (CPU_ISSET(c, &set))
+                    ret.emplace_back(c);
+#endif
+        return ret;
+    }
+
+    static void pin([[maybe_unused]] std::thread& thread, [[maybe_unused]] std::size_t const cpu)
+    {
+#if defined(__linux__)
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpu, &set);
+        pthread_setaffinity_np(thread.native_handle(), sizeof(set), &set);
+#endif
+    }
+
+    static inline thread_local bool inside = false;
+
+    std::vector<std::thread> workers;
+    std::mutex mutex, run_mutex;
+    std::condition_variable cv, done;
+    std::function<void(std::size_t)> const* task = nullptr;
+    std::exception_ptr error{};
+    std::size_t n_tasks = 0, pending = 0, generation = 0;
+    bool stop = false;
+};
+
+
+struct Sequential
+{
+    template<typename Fn>
+    void operator()(std::size_t const batches, std::size_t const /*batch_bytes*/,
+                    void const* const /*addr*/, Fn const& fn) const
+    {
+        fn(std::size_t{0}, batches);
+    }
+
+    std::size_t concurrency() const noexcept { return 1; }
+};
+
+struct Parallel
+{
+    ThreadPool* pool      = nullptr; // nullptr: ThreadPool::global()
+    std::size_t threads   = 0;       // 0: pool size
+    std::size_t min_bytes = 1 << 15; // per thread, below this fewer threads are used
+    Partition* report     = nullptr; // receives the partition of each call
+
+    auto on(ThreadPool& p) const noexcept { return Parallel{&p, threads, min_bytes, report}; }
+    auto with(std::size_t const t) const noexcept { return Parallel{pool, t, min_bytes, report}; }
+    auto report_to(Partition& p) const noexcept { return Parallel{pool, threads, min_bytes, &p}; }
+    auto min_bytes_per_thread(std::size_t const b) const noexcept
+    {
+        return Parallel{pool, threads, b, report};
+    }
+
+    // fn(begin, end) over batch ranges
+    template<typename Fn>
+    void operator()(std::size_t const batches, std::size_t const batch_bytes,
+                    void const* const addr, Fn const& fn) const
+    {
+        auto& p         = pool ? *pool : ThreadPool::global();
+        auto const part = partition(batches, batch_bytes, threads ? threads : p.size(), addr,
+                                    min_bytes);
+        p.run(part.threads(),
+              [&](std::size_t const t) { fn(part.ranges[t].first, part.ranges[t].second); });
+        if (report)
+            *report = part;
+    }
+
+    // threads a call may use, fewer run below min_bytes each
+    std::size_t concurrency() const
+    {
+        return threads ? threads : (pool ? *pool : ThreadPool::global()).size();
+    }
+};
+
+inline constexpr Sequential seq{};
+inline constexpr Parallel par{};
+
+template<typename P>
+inline constexpr bool is_policy_v = std::is_same_v<P, Sequential> or std::is_same_v<P, Parallel>;
+
+} // namespace mkn::avx
+
+#endif /* _MKN_AVX_PARALLEL_HPP_ */
@@ -34,18 +34,53 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "mkn/kul/span.hpp"
 
 #include "mkn/avx/def.hpp"
+#include "mkn/avx/math.hpp"
 #include "mkn/avx/unit.hpp"
 #include "mkn/avx/types.hpp"
 
+#include <cmath>
 #include <array>
 #include <cassert>
 #include <cstddef>
 #include <cstring>
+#include <limits>
+#include <utility>
 
 
-namespace mkn::avx
+namespace mkn::avx::inline MKN_AVX_TIER
 {
 
+// FAST: 4 independent accumulators per reduction to hide add/fma latency.
+//   lane order is fixed, so results are reproducible for a given N and size
+// KAHAN: compensated summation per lane, then across lanes, for results that
+//   stay close to the exact sum regardless of N. don't build with -ffast-math.
+enum class Summation : std::uint8_t { FAST = 0, KAHAN };
+
+// how batched results are written
+// CACHE: regular stores, through the cache
+// STREAM: non-temporal stores then an sfence. a regular store first reads the line
+//   it writes, streaming skips that, for results not read again soon. needs an
+//   aligned span and a width with stream (see has_stream), else it writes as CACHE
+// AUTO: STREAM for spans of at least Options::STREAM_BYTES(), CACHE below
+enum class Store : std::uint8_t { AUTO = 0, CACHE, STREAM };
+
+template<typename T>
+struct KahanSum
+{
+    void operator+=(T const x) noexcept
+    {
+        T const y = x - c;
+        T const t = s + y;
+        c         = (t - s) - y;
+        s         = t;
+    }
+
+    T operator()() const noexcept { return s; }
+
+    T s = 0, c = 0;
+};
+
+
 // contract: size() is an exact multiple of N - no remainder/tail handling.
 // callers that cannot guarantee this must use AsymmetricSpan instead.
 template<typename T, std::size_t _N = Options::N<T>()>
@@ -54,6 +89,14 @@ class Span : public Unit<T, _N>
     using Super = Unit<T, _N>;
     using R     = Super::R;
 
+    // indices for gather/scatter, index_t<R> in batches or int32_t lane by lane
+    template<typename I>
+    bool static constexpr is_wide_index_v
+        = sizeof(R) < 4 and std::is_same_v<std::decay_t<I>, std::int32_t>;
+    template<typename I, std::size_t M>
+    bool static constexpr is_index_v
+        = is_wide_index_v<I> or (std::is_same_v<std::decay_t<I>, detail::index_t<R>> and M == _N);
+
     template<typename, std::size_t>
     friend class Span;
     template<typename, std::size_t>
@@ -88,50 +131,304 @@ public:
     }
 
 
-    template<typename T0, typename T1>
+    template<Store S = Store::AUTO, typename T0, typename T1>
     void inline add(Span<T0, N> const& a, Span<T1, N> const& b) noexcept
     {
-        auto const& [v0, v1, v2] = cast(*this, a, b);
+        auto const& [v1, v2] = cast(a, b);
+        assign<S>([&](auto const i) { return v1[i] + v2[i]; });
+    }
+
+
+    template<Store S = Store::AUTO, typename T0, typename T1>
+    void inline sub(Span<T0, N> const& a, Span<T1, N> const& b) noexcept
+    {
+        auto const& [v1, v2] = cast(a, b);
+        assign<S>([&](auto const i) { return v1[i] - v2[i]; });
+    }
+
+
+
+    template<Store S = Store::AUTO, typename T0, typename T1>
+    void inline mul(Span<T0, N> const& a, Span<T1, N> const& b) noexcept
+    {
+        auto const& [v1, v2] = cast(a, b);
+        assign<S>([&](auto const i) { return v1[i] * v2[i]; });
+    }
+
+
+    template<Store S = Store::AUTO, typename T0, typename T1>
+    void inline div(Span<T0, N> const& a, Span<T1, N> const& b) noexcept
+    {
+        auto const& [v1, v2] = cast(a, b);
+        assign<S>([&](auto const i) { return v1[i] / v2[i]; });
+    }
+
+    template<typename T0, typename T1, typename T2>
+    void inline fma(Span<T0, N> const& a, Span<T1, N> const& b, Span<T2, N> const& c) noexcept
+    {
+        auto const& [v0, v1, v2, v3] = cast(*this, a, b, c);
         for (std::size_t i = 0; i < batches(); ++i)
-            v0[i] = v1[i] + v2[i];
+            v0[i] = mkn::avx::fma(v1[i], v2[i], v3[i]);
     }
 
+    // a * b - c
+    template<typename T0, typename T1, typename T2>
+    void inline fms(Span<T0, N> const& a, Span<T1, N> const& b, Span<T2, N> const& c) noexcept
+    {
+        auto const& [v0, v1, v2, v3] = cast(*this, a, b, c);
+        for (std::size_t i = 0; i < batches(); ++i)
+            v0[i] = mkn::avx::fms(v1[i], v2[i], v3[i]);
+    }
+
+    // c - a * b
+    template<typename T0, typename T1, typename T2>
+    void inline fnma(Span<T0, N> const& a, Span<T1, N> const& b, Span<T2, N> const& c) noexcept
+    {
+        auto const& [v0, v1, v2, v3] = cast(*this, a, b, c);
+        for (std::size_t i = 0; i < batches(); ++i)
+            v0[i] = mkn::avx::fnma(v1[i], v2[i], v3[i]);
+    }
+
+
+
+    // elementwise math.hpp functions, see there for accuracy
+    template<typename T0>
+    void inline exp(Span<T0, N> const& a) noexcept
+    {
+        auto const& [v0, v1] = cast(*this, a);
+        for (std::size_t i = 0; i < batches(); ++i)
+            v0[i] = mkn::avx::exp(v1[i]);
+    }
+
+    template<typename T0>
+    void inline log(Span<T0, N> const& a) noexcept
+    {
+        auto const& [v0, v1] = cast(*this, a);
+        for (std::size_t i = 0; i < batches(); ++i)
+            v0[i] = mkn::avx::log(v1[i]);
+    }
+
+    template<typename T0>
+    void inline sqrt(Span<T0, N> const& a) noexcept
+    {
+        auto const& [v0, v1] = cast(*this, a);
+        for (std::size_t i = 0; i < batches(); ++i)
+            v0[i] = mkn::avx::sqrt(v1[i]);
+    }
+
+    template<typename T0>
+    void inline rsqrt(Span<T0, N> const& a) noexcept
+    {
+        auto const& [v0, v1] = cast(*this, a);
+        for (std::size_t i = 0; i < batches(); ++i)
+            v0[i] = mkn::avx::rsqrt(v1[i]);
+    }
+
+    template<typename T0>
+    void inline sin(Span<T0, N> const& a) noexcept
+    {
+        auto const& [v0, v1] = cast(*this, a);
+        for (std::size_t i = 0; i < batches(); ++i)
+            v0[i] = mkn::avx::sin(v1[i]);
+    }
+
+    template<typename T0>
+    void inline cos(Span<T0, N> const& a) noexcept
+    {
+        auto const& [v0, v1] = cast(*this, a);
+        for (std::size_t i = 0; i < batches(); ++i)
+            v0[i] = mkn::avx::cos(v1[i]);
+    }
 
     template<typename T0, typename T1>
-    void inline sub(Span<T0, N> const& a, Span<T1, N> const& b) noexcept
+    void inline pow(Span<T0, N> const& a, Span<T1, N> const& b) noexcept
     {
         auto const& [v0, v1, v2] = cast(*this, a, b);
         for (std::size_t i = 0; i < batches(); ++i)
-            v0[i] = v1[i] - v2[i];
+            v0[i] = mkn::avx::pow(v1[i], v2[i]);
     }
 
+    template<typename T0>
+    void inline abs(Span<T0, N> const& a) noexcept
+    {
+        auto const& [v0, v1] = cast(*this, a);
+        for (std::size_t i = 0; i < batches(); ++i)
+            v0[i] = mkn::avx::abs(v1[i]);
+    }
 
+    template<typename T0>
+    void inline neg(Span<T0, N> const& a) noexcept
+    {
+        auto const& [v0, v1] = cast(*this, a);
+        for (std::size_t i = 0; i < batches(); ++i)
+            v0[i] = mkn::avx::neg(v1[i]);
+    }
 
+    // elementwise, NaN handling follows the min/max instructions
     template<typename T0, typename T1>
-    void inline mul(Span<T0, N> const& a, Span<T1, N> const& b) noexcept
+    void inline min(Span<T0, N> const& a, Span<T1, N> const& b) noexcept
     {
         auto const& [v0, v1, v2] = cast(*this, a, b);
         for (std::size_t i = 0; i < batches(); ++i)
-            v0[i] = v1[i] * v2[i];
+            v0[i] = mkn::avx::min(v1[i], v2[i]);
     }
 
-
     template<typename T0, typename T1>
-    void inline div(Span<T0, N> const& a, Span<T1, N> const& b) noexcept
+    void inline max(Span<T0, N> const& a, Span<T1, N> const& b) noexcept
     {
         auto const& [v0, v1, v2] = cast(*this, a, b);
         for (std::size_t i = 0; i < batches(); ++i)
-            v0[i] = v1[i] / v2[i];
+            v0[i] = mkn::avx::max(v1[i], v2[i]);
     }
 
-    template<typename T0, typename T1, typename T2>
-    void inline fma(Span<T0, N> const& a, Span<T1, N> const& b, Span<T2, N> const& c) noexcept
+    // span[i] = pred(a[i], b[i]) ? x[i] : y[i], branch free per batch
+    //   pred compares both Types and Ts, e.g. std::greater<>{}
+    template<typename Pred, typename T0, typename T1, typename T2, typename T3>
+    void inline select(Pred const& pred, Span<T0, N> const& a, Span<T1, N> const& b,
+                       Span<T2, N> const& x, Span<T3, N> const& y) noexcept
     {
-        auto const& [v0, v1, v2, v3] = cast(*this, a, b, c);
+        auto const& [v0, v1, v2, v3, v4] = cast(*this, a, b, x, y);
         for (std::size_t i = 0; i < batches(); ++i)
-            v0[i] = mkn::avx::fma(v1[i], v2[i], v3[i]);
+            v0[i] = mkn::avx::select(pred(v1[i], v2[i]), v3[i], v4[i]);
+    }
+
+    // span[i] op= x[i] only where pred(a[i], b[i])
+    template<typename Pred, typename T0, typename T1, typename T2>
+    void inline add_if(Pred const& pred, Span<T0, N> const& a, Span<T1, N> const& b,
+                       Span<T2, N> const& x) noexcept
+    {
+        auto const& [v0, v1, v2, v3] = cast(*this, a, b, x);
+        for (std::size_t i = 0; i < batches(); ++i)
+            where(pred(v1[i], v2[i]), v0[i]) += v3[i];
+    }
+
+    template<typename Pred, typename T0, typename T1, typename T2>
+    void inline mul_if(Pred const& pred, Span<T0, N> const& a, Span<T1, N> const& b,
+                       Span<T2, N> const& x) noexcept
+    {
+        auto const& [v0, v1, v2, v3] = cast(*this, a, b, x);
+        for (std::size_t i = 0; i < batches(); ++i)
+            where(pred(v1[i], v2[i]), v0[i]) *= v3[i];
+    }
+
+    // how many i have pred(span[i], b[i])
+    template<typename Pred, typename T0>
+    std::size_t inline count_if(Pred const& pred, Span<T0, N> const& b) const noexcept
+    {
+        auto const& [v0, v1] = cast(*this, b);
+        std::size_t ret      = 0;
+        for (std::size_t i = 0; i < batches(); ++i)
+            ret += mkn::avx::count(pred(v0[i], v1[i]));
+        return ret;
+    }
+
+
+    // indexed access through idx, a span of index_t<T> - a may be any size, idx
+    // must be within it. see gather/scatter in types.hpp for the instructions used.
+    // 8 and 16 bit lanes also take int32_t indices, to reach past their index_t,
+    // which go lane by lane as those widths do in registers anyway
+    //   span[i] = a[idx[i]]
+    template<typename T0, typename I, std::size_t M>
+    void inline gather(Span<T0, N> const& a, Span<I, M> const& idx) noexcept
+    {
+        static_assert(is_index_v<I, M>);
+        if constexpr (is_wide_index_v<I>)
+            for (std::size_t i = 0; i < batches() * N; ++i)
+                span[i] = a.span[idx.span[i]];
+        else
+        {
+            auto const& [v0] = cast(*this);
+            for (std::size_t i = 0; i < batches(); ++i)
+                v0[i] = mkn::avx::gather<R, N>(a.span.data(), idx.avx()[i]);
+        }
+    }
+
+    //   a[idx[i]] = span[i], the last of repeated indices wins
+    template<typename T0, typename I, std::size_t M>
+    void inline scatter(Span<T0, N> const& a, Span<I, M> const& idx) const noexcept
+    {
+        static_assert(is_index_v<I, M>);
+        if constexpr (is_wide_index_v<I>)
+            for (std::size_t i = 0; i < batches() * N; ++i)
+                a.span[idx.span[i]] = span[i];
+        else
+        {
+            auto const& [v0] = cast(*this);
+            for (std::size_t i = 0; i < batches(); ++i)
+                mkn::avx::scatter<R, N>(a.span.data(), idx.avx()[i], v0[i]);
+        }
+    }
+
+    //   a[idx[i]] += span[i], repeated indices accumulate
+    template<typename T0, typename I, std::size_t M>
+    void inline scatter_add(Span<T0, N> const& a, Span<I, M> const& idx) const noexcept
+    {
+        static_assert(is_index_v<I, M>);
+        if constexpr (is_wide_index_v<I>)
+            for (std::size_t i = 0; i < batches() * N; ++i)
+                a.span[idx.span[i]] += span[i];
+        else
+        {
+            auto const& [v0] = cast(*this);
+            for (std::size_t i = 0; i < batches(); ++i)
+                mkn::avx::scatter_add<R, N>(a.span.data(), idx.avx()[i], v0[i]);
+        }
+    }
+
+
+    // policy is an execution policy, see parallel.hpp, and S is as without one.
+    // pass *this as an operand for the in place, += style, variant - e.g.
+    // a.add(a, b, par) or a.add<Store::STREAM>(a, b, par)
+    template<Store S = Store::AUTO, typename T0, typename T1, typename Policy>
+    void inline add(Span<T0, N> const& a, Span<T1, N> const& b, Policy const& policy)
+    {
+        bool const stream = streams<S>();
+        policy(batches(), sizeof(AVX_t), data(), [&](auto const begin, auto const end) {
+            auto const& [v1, v2] = cast(a, b);
+            assign([&](auto const i) { return v1[i] + v2[i]; }, begin, end, stream);
+        });
+    }
+
+    template<Store S = Store::AUTO, typename T0, typename T1, typename Policy>
+    void inline sub(Span<T0, N> const& a, Span<T1, N> const& b, Policy const& policy)
+    {
+        bool const stream = streams<S>();
+        policy(batches(), sizeof(AVX_t), data(), [&](auto const begin, auto const end) {
+            auto const& [v1, v2] = cast(a, b);
+            assign([&](auto const i) { return v1[i] - v2[i]; }, begin, end, stream);
+        });
     }
 
+    template<Store S = Store::AUTO, typename T0, typename T1, typename Policy>
+    void inline mul(Span<T0, N> const& a, Span<T1, N> const& b, Policy const& policy)
+    {
+        bool const stream = streams<S>();
+        policy(batches(), sizeof(AVX_t), data(), [&](auto const begin, auto const end) {
+            auto const& [v1, v2] = cast(a, b);
+            assign([&](auto const i) { return v1[i] * v2[i]; }, begin, end, stream);
+        });
+    }
+
+    template<Store S = Store::AUTO, typename T0, typename T1, typename Policy>
+    void inline div(Span<T0, N> const& a, Span<T1, N> const& b, Policy const& policy)
+    {
+        bool const stream = streams<S>();
+        policy(batches(), sizeof(AVX_t), data(), [&](auto const begin, auto const end) {
+            auto const& [v1, v2] = cast(a, b);
+            assign([&](auto const i) { return v1[i] / v2[i]; }, begin, end, stream);
+        });
+    }
+
+    template<typename T0, typename T1, typename T2, typename Policy>
+    void inline fma(Span<T0, N> const& a, Span<T1, N> const& b, Span<T2, N> const& c,
+                    Policy const& policy)
+    {
+        policy(batches(), sizeof(AVX_t), data(), [&](auto const begin, auto const end) {
+            auto const& [v0, v1, v2, v3] = cast(*this, a, b, c);
+            for (std::size_t i = begin; i < end; ++i)
+                v0[i] = mkn::avx::fma(v1[i], v2[i], v3[i]);
+        });
+    }
 
 
     template<typename T0>
@@ -214,11 +511,51 @@ public:
         (*this) /= scratch;
     }
 
+    template<Summation S = Summation::FAST>
+    R sum() const noexcept
+    {
+        return accumulate<S>(0, span.data())();
+    }
+
+    template<Summation S = Summation::FAST, typename T0>
+    R dot(Span<T0, N> const& that) const noexcept
+    {
+        return accumulate<S>(0, span.data(), that.span.data())();
+    }
+
+    template<Summation S = Summation::FAST>
+    R norm() const noexcept
+    {
+        return std::sqrt(dot<S>(*this));
+    }
+
+    // NaN handling follows the min/max instructions, the second operand is
+    // taken when either is NaN, so whether one propagates depends on where it
+    // is. min() of an empty span is +inf, max() -inf, or the largest and
+    // lowest value for integers
+    R min() const noexcept { return extreme(_min_, 0); }
+    R max() const noexcept { return extreme(_max_, 0); }
+
     template<typename T0>
     auto& operator=(T0 const& that) noexcept
+    {
+        return copy(that);
+    }
+
+    // operator= with a choice of Store, that may be unaligned
+    template<Store S = Store::AUTO, typename T0>
+    auto& copy(T0 const& that) noexcept
     {
         static_assert(std::is_same_v<R, std::decay_t<typename T0::value_type>>);
-        std::memcpy(data(), that.data(), sizeof(T) * size());
+        if (!has_stream_v<R, N> or !streams<S>())
+        {
+            std::memcpy(data(), that.data(), sizeof(T) * size());
+            return *this;
+        }
+        auto const* p = that.data();
+        assign<S>([&](auto const i) { return unaligned_load<R, N>(p + i * N); });
+        auto const end = batches() * N;
+        std::memcpy(data() + end, p + end, sizeof(T) * (size() - end));
         return *this;
     }
 
@@ -253,14 +590,173 @@ public:
 protected:
     std::size_t batches() const { return size() / N; }
 
+    // stream needs the full width aligned, which Options::ALIGN() may be below
+    template<Store S>
+    bool streams() const noexcept
+    {
+        if constexpr (S == Store::CACHE)
+            return false;
+        else if constexpr (S == Store::STREAM)
+            return is_aligned_pointer<T, sizeof(AVX_t)>(span.data());
+        else
+            return size() * sizeof(T) >= Options::STREAM_BYTES()
+                   and is_aligned_pointer<T, sizeof(AVX_t)>(span.data());
+    }
+
+    // batch i = fn(i) for each batch, see Store
+    template<Store S, typename Fn>
+    void inline assign(Fn const& fn) noexcept
+    {
+        assign(fn, 0, batches(), streams<S>());
+    }
+
+    // batch i = fn(i) for batches [begin, end), streamed then fenced if stream -
+    // an sfence orders only the calling thread's stores, so each worker fences
+    template<typename Fn>
+    void inline assign(Fn const& fn, std::size_t const begin, std::size_t const end,
+                       [[maybe_unused]] bool const stream) noexcept
+    {
+        if constexpr (has_stream_v<R, N>)
+            if (stream)
+            {
+                for (std::size_t i = begin; i < end; ++i)
+                    mkn::avx::stream(data() + i * N, fn(i));
+                _mm_sfence();
+                return;
+            }
+
+        auto const& [v0] = cast(*this);
+        for (std::size_t i = begin; i < end; ++i)
+            v0[i] = fn(i);
+    }
+
+    auto constexpr static _min_ = [](auto const& a, auto const& b) {
+        if constexpr (std::is_arithmetic_v<std::decay_t<decltype(a)>>)
+            return a < b ? a : b;
+        else
+            return mkn::avx::min(a, b);
+    };
+    auto constexpr static _max_ = [](auto const& a, auto const& b) {
+        if constexpr (std::is_arithmetic_v<std::decay_t<decltype(a)>>)
+            return a > b ? a : b;
+        else
+            return mkn::avx::max(a, b);
+    };
+
+    // sum of the elementwise product of ps over batches() and then the
+    // following tail elements
+    template<Summation S, typename... Ps>
+    KahanSum<R> accumulate(std::size_t const tail, Ps const*... ps) const noexcept
+    {
+        static_assert(sizeof...(Ps) == 1 or sizeof...(Ps) == 2);
+
+        AVX_t const zero{load<R, N>(0)};
+        auto const fold = [](AVX_t& acc, auto const&... vs) {
+            if constexpr (sizeof...(vs) == 1)
+                acc += (vs, ...);
+            else if constexpr (Options::FMA)
+                acc = mkn::avx::fma(vs..., acc);
+            else
+                acc += (vs * ...);
+        };
+
+        KahanSum<R> ret;
+        std::size_t const end = batches() * N;
+        auto const lanes      = [&](AVX_t const& s, AVX_t const& c) {
+            auto const* sl = reinterpret_cast<R const*>(&s());
+            auto const* cl = reinterpret_cast<R const*>(&c());
+            for (std::size_t l = 0; l < N; ++l)
+                ret += sl[l], ret += -cl[l];
+        };
+
+        if constexpr (S == Summation::FAST)
+        {
+            std::array<AVX_t, 4> acc{zero, zero, zero, zero};
+            std::size_t i = 0;
+            for (; i + 4 <= batches(); i += 4)
+                for (std::size_t a = 0; a < 4; ++a)
+                    fold(acc[a], unaligned_load<R, N>(ps + (i + a) * N)...);
+            for (; i < batches(); ++i)
+                fold(acc[0], unaligned_load<R, N>(ps + i * N)...);
+
+            if constexpr (has_masked_v<R, N> and Options::AVX)
+                if (tail > 0)
+                    fold(acc[1], AVX_t{Type_<R, N>::masked_load(ps + end, tail)}...);
+
+            acc[0] += acc[1];
+            acc[2] += acc[3];
+            acc[0] += acc[2];
+            ret.s = hsum(acc[0]);
+        }
+        else
+        {
+            AVX_t s = zero, c = zero;
+            auto const kahan = [&](auto const&... vs) {
+                AVX_t y = zero;
+                fold(y, vs...);
+                y -= c;
+                auto const t = s + y;
+                c            = (t - s) - y;
+                s            = t;
+            };
+            for (std::size_t i = 0; i < batches(); ++i)
+                kahan(unaligned_load<R, N>(ps + i * N)...);
+
+            if constexpr (has_masked_v<R, N> and Options::AVX)
+                if (tail > 0)
+                    kahan(AVX_t{Type_<R, N>::masked_load(ps + end, tail)}...);
+
+            lanes(s, c);
+        }
+
+        if constexpr (!(has_masked_v<R, N> and Options::AVX))
+            for (std::size_t i = end; i < end + tail; ++i)
+                ret += (ps[i] * ...);
+
+        return ret;
+    }
+
+    // op folded over batches() and then the following tail elements, see min()
+    template<typename Op>
+    R extreme(Op const& op, std::size_t const tail) const noexcept
+    {
+        if (size() == 0)
+        {
+            using L = std::numeric_limits<R>;
+            if constexpr (std::is_same_v<Op, std::decay_t<decltype(_min_)>>)
+                return L::has_infinity ? L::infinity() : L::max();
+            else
+                return L::has_infinity ? -L::infinity() : L::lowest();
+        }
+
+        auto const* p = span.data();
+        R ret         = p[0];
+        if (batches() > 0)
+        {
+            AVX_t const first = unaligned_load<R, N>(p);
+            std::array<AVX_t, 4> acc{first, first, first, first};
+            std::size_t i = 1;
+            for (; i + 4 <= batches(); i += 4)
+                for (std::size_t a = 0; a < 4; ++a)
+                    acc[a] = op(acc[a], unaligned_load<R, N>(p + (i + a) * N));
+            for (; i < batches(); ++i)
+                acc[0] = op(acc[0], unaligned_load<R, N>(p + i * N));
+            ret = reduce(op(op(acc[0], acc[1]), op(acc[2], acc[3])), op);
+        }
+        for (std::size_t i = batches() * N; i < batches() * N + tail; ++i)
+            ret = op(ret, p[i]);
+        return ret;
+    }
+
 private:
     alignas(Options::ALIGN()) std::array<T, N> scratch{};
 };
 
 
 // arbitrary/unknown size - not guaranteed to be an exact multiple of N, so
-// every op runs Span's batched loop and then mops up the ragged tail with a
-// scalar pass over [modulo_leftover_idx(), size())
+// every op runs Span's batched loop and then finishes the ragged tail over
+// [modulo_leftover_idx(), size()) - one masked vector step where the width
+// supports it (see has_masked), a scalar pass otherwise
 template<typename T, std::size_t _N = Options::N<T>()>
 class AsymmetricSpan : public Span<T, _N>
 {
@@ -289,52 +785,69 @@ public:
     using Super::mul;
     using Super::div;
     using Super::fma;
+    using Super::fms;
+    using Super::fnma;
+    using Super::exp;
+    using Super::log;
+    using Super::sqrt;
+    using Super::rsqrt;
+    using Super::sin;
+    using Super::cos;
+    using Super::pow;
+    using Super::abs;
+    using Super::neg;
+    using Super::min;
+    using Super::max;
+    using Super::select;
+    using Super::add_if;
+    using Super::mul_if;
+    using Super::count_if;
+    using Super::gather;
+    using Super::scatter;
+    using Super::scatter_add;
     using Super::operator+=;
     using Super::operator-=;
     using Super::operator*=;
     using Super::operator/=;
     using Super::operator=;
     using Super::operator==;
+    using Super::copy;
     using Super::size;
 
-    template<typename T0, typename T1>
+    template<Store S = Store::AUTO, typename T0, typename T1>
     void inline add(AsymmetricSpan<T0, N> const& a, AsymmetricSpan<T1, N> const& b) noexcept
     {
         Span<T0, N> const& sa = a;
         Span<T1, N> const& sb = b;
-        Super::add(sa, sb);
-        for (std::size_t i = modulo_leftover_idx(); i < size(); ++i)
-            span[i] = a.span[i] + b.span[i];
+        Super::template add<S>(sa, sb);
+        leftover(_add_, a.span.data(), b.span.data());
     }
 
-    template<typename T0, typename T1>
+    template<Store S = Store::AUTO, typename T0, typename T1>
     void inline sub(AsymmetricSpan<T0, N> const& a, AsymmetricSpan<T1, N> const& b) noexcept
     {
         Span<T0, N> const& sa = a;
         Span<T1, N> const& sb = b;
-        Super::sub(sa, sb);
-        for (std::size_t i = modulo_leftover_idx(); i < size(); ++i)
-            span[i] = a.span[i] - b.span[i];
+        Super::template sub<S>(sa, sb);
+        leftover(_sub_, a.span.data(), b.span.data());
     }
 
-    template<typename T0, typename T1>
+    template<Store S = Store::AUTO, typename T0, typename T1>
     void inline mul(AsymmetricSpan<T0, N> const& a, AsymmetricSpan<T1, N> const& b) noexcept
     {
         Span<T0, N> const& sa = a;
         Span<T1, N> const& sb = b;
-        Super::mul(sa, sb);
-        for (std::size_t i = modulo_leftover_idx(); i < size(); ++i)
-            span[i] = a.span[i] * b.span[i];
+        Super::template mul<S>(sa, sb);
+        leftover(_mul_, a.span.data(), b.span.data());
     }
 
-    template<typename T0, typename T1>
+    template<Store S = Store::AUTO, typename T0, typename T1>
     void inline div(AsymmetricSpan<T0, N> const& a, AsymmetricSpan<T1, N> const& b) noexcept
     {
         Span<T0, N> const& sa = a;
         Span<T1, N> const& sb = b;
-        Super::div(sa, sb);
-        for (std::size_t i = modulo_leftover_idx(); i < size(); ++i)
-            span[i] = a.span[i] / b.span[i];
+        Super::template div<S>(sa, sb);
+        leftover(_div_, a.span.data(), b.span.data());
     }
 
     template<typename T0, typename T1, typename T2>
@@ -345,8 +858,256 @@ public:
         Span<T1, N> const& sb = b;
         Span<T2, N> const& sc = c;
         Super::fma(sa, sb, sc);
+        leftover(_fma_, a.span.data(), b.span.data(), c.span.data());
+    }
+
+    template<typename T0, typename T1, typename T2>
+    void inline fms(AsymmetricSpan<T0, N> const& a, AsymmetricSpan<T1, N> const& b,
+                    AsymmetricSpan<T2, N> const& c) noexcept
+    {
+        Span<T0, N> const& sa = a;
+        Span<T1, N> const& sb = b;
+        Span<T2, N> const& sc = c;
+        Super::fms(sa, sb, sc);
+        leftover(_fms_, a.span.data(), b.span.data(), c.span.data());
+    }
+
+    template<typename T0, typename T1, typename T2>
+    void inline fnma(AsymmetricSpan<T0, N> const& a, AsymmetricSpan<T1, N> const& b,
+                     AsymmetricSpan<T2, N> const& c) noexcept
+    {
+        Span<T0, N> const& sa = a;
+        Span<T1, N> const& sb = b;
+        Span<T2, N> const& sc = c;
+        Super::fnma(sa, sb, sc);
+        leftover(_fnma_, a.span.data(), b.span.data(), c.span.data());
+    }
+
+    template<Store S = Store::AUTO, typename T0, typename T1, typename Policy>
+    void inline add(AsymmetricSpan<T0, N> const& a, AsymmetricSpan<T1, N> const& b,
+                    Policy const& policy)
+    {
+        Span<T0, N> const& sa = a;
+        Span<T1, N> const& sb = b;
+        Super::template add<S>(sa, sb, policy);
+        leftover(_add_, a.span.data(), b.span.data());
+    }
+
+    template<Store S = Store::AUTO, typename T0, typename T1, typename Policy>
+    void inline sub(AsymmetricSpan<T0, N> const& a, AsymmetricSpan<T1, N> const& b,
+                    Policy const& policy)
+    {
+        Span<T0, N> const& sa = a;
+        Span<T1, N> const& sb = b;
+        Super::template sub<S>(sa, sb, policy);
+        leftover(_sub_, a.span.data(), b.span.data());
+    }
+
+    template<Store S = Store::AUTO, typename T0, typename T1, typename Policy>
+    void inline mul(AsymmetricSpan<T0, N> const& a, AsymmetricSpan<T1, N> const& b,
+                    Policy const& policy)
+    {
+        Span<T0, N> const& sa = a;
+        Span<T1, N> const& sb = b;
+        Super::template mul<S>(sa, sb, policy);
+        leftover(_mul_, a.span.data(), b.span.data());
+    }
+
+    template<Store S = Store::AUTO, typename T0, typename T1, typename Policy>
+    void inline div(AsymmetricSpan<T0, N> const& a, AsymmetricSpan<T1, N> const& b,
+                    Policy const& policy)
+    {
+        Span<T0, N> const& sa = a;
+        Span<T1, N> const& sb = b;
+        Super::template div<S>(sa, sb, policy);
+        leftover(_div_, a.span.data(), b.span.data());
+    }
+
+    template<typename T0, typename T1, typename T2, typename Policy>
+    void inline fma(AsymmetricSpan<T0, N> const& a, AsymmetricSpan<T1, N> const& b,
+                    AsymmetricSpan<T2, N> const& c, Policy const& policy)
+    {
+        Span<T0, N> const& sa = a;
+        Span<T1, N> const& sb = b;
+        Span<T2, N> const& sc = c;
+        Super::fma(sa, sb, sc, policy);
+        leftover(_fma_, a.span.data(), b.span.data(), c.span.data());
+    }
+
+    template<typename T0>
+    void inline exp(AsymmetricSpan<T0, N> const& a) noexcept
+    {
+        Span<T0, N> const& sa = a;
+        Super::exp(sa);
+        leftover(_exp_, a.span.data());
+    }
+
+    template<typename T0>
+    void inline log(AsymmetricSpan<T0, N> const& a) noexcept
+    {
+        Span<T0, N> const& sa = a;
+        Super::log(sa);
+        leftover(_log_, a.span.data());
+    }
+
+    template<typename T0>
+    void inline sqrt(AsymmetricSpan<T0, N> const& a) noexcept
+    {
+        Span<T0, N> const& sa = a;
+        Super::sqrt(sa);
+        leftover(_sqrt_, a.span.data());
+    }
+
+    template<typename T0>
+    void inline rsqrt(AsymmetricSpan<T0, N> const& a) noexcept
+    {
+        Span<T0, N> const& sa = a;
+        Super::rsqrt(sa);
+        leftover(_rsqrt_, a.span.data());
+    }
+
+    template<typename T0>
+    void inline sin(AsymmetricSpan<T0, N> const& a) noexcept
+    {
+        Span<T0, N> const& sa = a;
+        Super::sin(sa);
+        leftover(_sin_, a.span.data());
+    }
+
+    template<typename T0>
+    void inline cos(AsymmetricSpan<T0, N> const& a) noexcept
+    {
+        Span<T0, N> const& sa = a;
+        Super::cos(sa);
+        leftover(_cos_, a.span.data());
+    }
+
+    template<typename T0, typename T1>
+    void inline pow(AsymmetricSpan<T0, N> const& a, AsymmetricSpan<T1, N> const& b) noexcept
+    {
+        Span<T0, N> const& sa = a;
+        Span<T1, N> const& sb = b;
+        Super::pow(sa, sb);
+        leftover(_pow_, a.span.data(), b.span.data());
+    }
+
+    template<typename T0>
+    void inline abs(AsymmetricSpan<T0, N> const& a) noexcept
+    {
+        Span<T0, N> const& sa = a;
+        Super::abs(sa);
+        leftover(_abs_, a.span.data());
+    }
+
+    template<typename T0>
+    void inline neg(AsymmetricSpan<T0, N> const& a) noexcept
+    {
+        Span<T0, N> const& sa = a;
+        Super::neg(sa);
+        leftover(_neg_, a.span.data());
+    }
+
+    template<typename T0, typename T1>
+    void inline min(AsymmetricSpan<T0, N> const& a, AsymmetricSpan<T1, N> const& b) noexcept
+    {
+        Span<T0, N> const& sa = a;
+        Span<T1, N> const& sb = b;
+        Super::min(sa, sb);
+        leftover(Super::_min_, a.span.data(), b.span.data());
+    }
+
+    template<typename T0, typename T1>
+    void inline max(AsymmetricSpan<T0, N> const& a, AsymmetricSpan<T1, N> const& b) noexcept
+    {
+        Span<T0, N> const& sa = a;
+        Span<T1, N> const& sb = b;
+        Super::max(sa, sb);
+        leftover(Super::_max_, a.span.data(), b.span.data());
+    }
+
+    template<typename Pred, typename T0, typename T1, typename T2, typename T3>
+    void inline select(Pred const& pred, AsymmetricSpan<T0, N> const& a,
+                       AsymmetricSpan<T1, N> const& b, AsymmetricSpan<T2, N> const& x,
+                       AsymmetricSpan<T3, N> const& y) noexcept
+    {
+        Span<T0, N> const& sa = a;
+        Span<T1, N> const& sb = b;
+        Span<T2, N> const& sx = x;
+        Span<T3, N> const& sy = y;
+        Super::select(pred, sa, sb, sx, sy);
+        leftover([&](auto const& p, auto const& q, auto const& u,
+                     auto const& v) { return _select_(pred(p, q), u, v); },
+                 a.span.data(), b.span.data(), x.span.data(), y.span.data());
+    }
+
+    template<typename Pred, typename T0, typename T1, typename T2>
+    void inline add_if(Pred const& pred, AsymmetricSpan<T0, N> const& a,
+                       AsymmetricSpan<T1, N> const& b, AsymmetricSpan<T2, N> const& x) noexcept
+    {
+        Span<T0, N> const& sa = a;
+        Span<T1, N> const& sb = b;
+        Span<T2, N> const& sx = x;
+        Super::add_if(pred, sa, sb, sx);
+        leftover([&](auto const& s, auto const& p, auto const& q,
+                     auto const& u) { return _select_(pred(p, q), _add_(s, u), s); },
+                 span.data(), a.span.data(), b.span.data(), x.span.data());
+    }
+
+    template<typename Pred, typename T0, typename T1, typename T2>
+    void inline mul_if(Pred const& pred, AsymmetricSpan<T0, N> const& a,
+                       AsymmetricSpan<T1, N> const& b, AsymmetricSpan<T2, N> const& x) noexcept
+    {
+        Span<T0, N> const& sa = a;
+        Span<T1, N> const& sb = b;
+        Span<T2, N> const& sx = x;
+        Super::mul_if(pred, sa, sb, sx);
+        leftover([&](auto const& s, auto const& p, auto const& q,
+                     auto const& u) { return _select_(pred(p, q), _mul_(s, u), s); },
+                 span.data(), a.span.data(), b.span.data(), x.span.data());
+    }
+
+    // scalar tails, masked lanes would still be indexed
+    template<typename T0, typename I, std::size_t M>
+    void inline gather(AsymmetricSpan<T0, N> const& a, AsymmetricSpan<I, M> const& idx) noexcept
+    {
+        Span<T0, N> const& sa  = a;
+        Span<I, M> const& sidx = idx;
+        Super::gather(sa, sidx);
         for (std::size_t i = modulo_leftover_idx(); i < size(); ++i)
-            span[i] = a.span[i] * b.span[i] + c.span[i];
+            span[i] = a.span[idx.span[i]];
+    }
+
+    template<typename T0, typename I, std::size_t M>
+    void inline scatter(AsymmetricSpan<T0, N> const& a,
+                        AsymmetricSpan<I, M> const& idx) const noexcept
+    {
+        Span<T0, N> const& sa  = a;
+        Span<I, M> const& sidx = idx;
+        Super::scatter(sa, sidx);
+        for (std::size_t i = modulo_leftover_idx(); i < size(); ++i)
+            a.span[idx.span[i]] = span[i];
+    }
+
+    template<typename T0, typename I, std::size_t M>
+    void inline scatter_add(AsymmetricSpan<T0, N> const& a,
+                            AsymmetricSpan<I, M> const& idx) const noexcept
+    {
+        Span<T0, N> const& sa  = a;
+        Span<I, M> const& sidx = idx;
+        Super::scatter_add(sa, sidx);
+        for (std::size_t i = modulo_leftover_idx(); i < size(); ++i)
+            a.span[idx.span[i]] += span[i];
+    }
+
+    // the tail is scalar, zeroed masked lanes could satisfy pred
+    template<typename Pred, typename T0>
+    std::size_t inline count_if(Pred const& pred, AsymmetricSpan<T0, N> const& b) const noexcept
+    {
+        Span<T0, N> const& sb = b;
+        std::size_t ret       = Super::count_if(pred, sb);
+        for (std::size_t i = modulo_leftover_idx(); i < size(); ++i)
+            ret += pred(span[i], b.span[i]);
+        return ret;
     }
 
     template<typename T0>
@@ -354,8 +1115,7 @@ public:
     {
         Span<T0, N> const& sthat = that;
         Super::operator+=(sthat);
-        for (std::size_t i = modulo_leftover_idx(); i < size(); ++i)
-            span[i] += that.span[i];
+        leftover(_add_, span.data(), that.span.data());
     }
 
     template<typename T0>
@@ -363,8 +1123,7 @@ public:
     {
         Span<T0, N> const& sthat = that;
         Super::operator-=(sthat);
-        for (std::size_t i = modulo_leftover_idx(); i < size(); ++i)
-            (*this)[i] -= that[i];
+        leftover(_sub_, span.data(), that.span.data());
     }
 
     template<typename T0>
@@ -372,8 +1131,7 @@ public:
     {
         Span<T0, N> const& sthat = that;
         Super::operator*=(sthat);
-        for (std::size_t i = modulo_leftover_idx(); i < size(); ++i)
-            span[i] *= that.span[i];
+        leftover(_mul_, span.data(), that.span.data());
     }
 
     template<typename T0>
@@ -381,13 +1139,152 @@ public:
     {
         Span<T0, N> const& sthat = that;
         Super::operator/=(sthat);
-        for (std::size_t i = modulo_leftover_idx(); i < size(); ++i)
-            span[i] /= that.span[i];
+        leftover(_div_, span.data(), that.span.data());
+    }
+
+    template<Summation S = Summation::FAST>
+    R sum() const noexcept
+    {
+        return this->template accumulate<S>(size() % N, span.data())();
     }
 
+    template<Summation S = Summation::FAST, typename T0>
+    R dot(AsymmetricSpan<T0, N> const& that) const noexcept
+    {
+        return this->template accumulate<S>(size() % N, span.data(), that.span.data())();
+    }
+
+    template<Summation S = Summation::FAST>
+    R norm() const noexcept
+    {
+        return std::sqrt(dot<S>(*this));
+    }
+
+    R min() const noexcept { return this->extreme(Super::_min_, size() % N); }
+    R max() const noexcept { return this->extreme(Super::_max_, size() % N); }
+
 protected:
     auto modulo_leftover_idx(auto const siz) const { return siz - siz % N; }
     auto modulo_leftover_idx() const { return modulo_leftover_idx(size()); }
+
+    // ops usable on both AVX_t and R
+    auto constexpr static _add_ = [](auto const& a, auto const& b) { return a + b; };
+    auto constexpr static _sub_ = [](auto const& a, auto const& b) { return a - b; };
+    auto constexpr static _mul_ = [](auto const& a, auto const& b) { return a * b; };
+    auto constexpr static _div_ = [](auto const& a, auto const& b) { return a / b; };
+    auto constexpr static _fma_ = [](auto const& a, auto const& b, auto const& c) {
+        if constexpr (std::is_arithmetic_v<std::decay_t<decltype(a)>>)
+            return a * b + c;
+        else
+            return mkn::avx::fma(a, b, c);
+    };
+    auto constexpr static _fms_ = [](auto const& a, auto const& b, auto const& c) {
+        if constexpr (std::is_arithmetic_v<std::decay_t<decltype(a)>>)
+            return a * b - c;
+        else
+            return mkn::avx::fms(a, b, c);
+    };
+    auto constexpr static _fnma_ = [](auto const& a, auto const& b, auto const& c) {
+        if constexpr (std::is_arithmetic_v<std::decay_t<decltype(a)>>)
+            return c - a * b;
+        else
+            return mkn::avx::fnma(a, b, c);
+    };
+    auto constexpr static _exp_ = [](auto const& a) {
+        if constexpr (std::is_arithmetic_v<std::decay_t<decltype(a)>>)
+            return std::exp(a);
+        else
+            return mkn::avx::exp(a);
+    };
+    auto constexpr static _log_ = [](auto const& a) {
+        if constexpr (std::is_arithmetic_v<std::decay_t<decltype(a)>>)
+            return std::log(a);
+        else
+            return mkn::avx::log(a);
+    };
+    auto constexpr static _sqrt_ = [](auto const& a) {
+        if constexpr (std::is_arithmetic_v<std::decay_t<decltype(a)>>)
+            return std::sqrt(a);
+        else
+            return mkn::avx::sqrt(a);
+    };
+    auto constexpr static _rsqrt_ = [](auto const& a) {
+        if constexpr (std::is_arithmetic_v<std::decay_t<decltype(a)>>)
+            return 1 / std::sqrt(a);
+        else
+            return mkn::avx::rsqrt(a);
+    };
+    auto constexpr static _sin_ = [](auto const& a) {
+        if constexpr (std::is_arithmetic_v<std::decay_t<decltype(a)>>)
+            return std::sin(a);
+        else
+            return mkn::avx::sin(a);
+    };
+    auto constexpr static _cos_ = [](auto const& a) {
+        if constexpr (std::is_arithmetic_v<std::decay_t<decltype(a)>>)
+            return std::cos(a);
+        else
+            return mkn::avx::cos(a);
+    };
+    auto constexpr static _pow_ = [](auto const& a, auto const& b) {
+        if constexpr (std::is_arithmetic_v<std::decay_t<decltype(a)>>)
+            return std::pow(a, b);
+        else
+            return mkn::avx::pow(a, b);
+    };
+    auto constexpr static _abs_ = [](auto const& a) {
+        if constexpr (std::is_arithmetic_v<std::decay_t<decltype(a)>>)
+            return std::abs(a);
+        else
+            return mkn::avx::abs(a);
+    };
+    auto constexpr static _neg_ = [](auto const& a) {
+        if constexpr (std::is_arithmetic_v<std::decay_t<decltype(a)>>)
+            return -a;
+        else
+            return mkn::avx::neg(a);
+    };
+    auto constexpr static _select_ = [](auto const& m, auto const& a, auto const& b) {
+        if constexpr (std::is_arithmetic_v<std::decay_t<decltype(a)>>)
+            return m ? a : b;
+        else
+            return mkn::avx::select(m, a, b);
+    };
+
+    // input I of op over the first n lanes from p, the other lanes are zero
+    //   but one for a divisor, an rsqrt operand and a pow base, so the tail does
+    //   no 0 / 0, 1 / sqrt(0) or log(0) and raises no FE_INVALID or FE_DIVBYZERO
+    template<typename Op, std::size_t I, typename In>
+    auto static inline masked_in(In const* p, std::size_t const n) noexcept
+    {
+        using Impl = Type_<R, N>;
+        auto constexpr is
+            = [](auto const& f) { return std::is_same_v<Op, std::decay_t<decltype(f)>>; };
+        if constexpr ((is(_div_) and I == 1) or (is(_rsqrt_) and I == 0)
+                      or (is(_pow_) and I == 0))
+            return AVX_t{Impl::masked_fill(Impl::masked_load(p, n), n, R{1})};
+        else
+            return AVX_t{Impl::masked_load(p, n)};
+    }
+
+    // span[i] = op(ins[i]...) over [modulo_leftover_idx(), size())
+    template<typename Op, typename... Ins>
+    void inline leftover(Op const& op, Ins const*... ins) noexcept
+    {
+        auto const idx = modulo_leftover_idx();
+        if constexpr (has_masked_v<R, N> and Options::AVX)
+        {
+            using Impl = Type_<R, N>;
+            if (auto const n = size() - idx; n > 0)
+                [&]<std::size_t... I>(std::index_sequence<I...>) {
+                    Impl::masked_store(span.data() + idx,
+                                       op(masked_in<Op, I>(ins + idx, n)...)(), n);
+                }(std::index_sequence_for<Ins...>{});
+        }
+        else
+            for (std::size_t i = idx; i < size(); ++i)
+                span[i] = op(ins[i]...);
+    }
 };
 
 
@@ -416,8 +1313,7 @@ public:
             v0 += unaligned_load<R, N>(&that.span[idx]);
             unaligned_store(&this->span[idx], v0);
         }
-        for (std::size_t i = this->modulo_leftover_idx(); i < this->size(); ++i)
-            this->span[i] += that.span[i];
+        this->leftover(Super::_add_, this->span.data(), that.span.data());
     }
 
     auto& operator[](std::size_t i) const noexcept { return this->span[i]; }
@@ -31,11 +31,15 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef _MKN_AVX_TYPES_HPP_
 #define _MKN_AVX_TYPES_HPP_
 
+#include <bit>
+#include <limits>
 #include <cstdint>
+#include <cstring>
 #include <utility>
+#include <type_traits>
 #include <immintrin.h> // avx
 
-namespace mkn::avx
+namespace mkn::avx::inline MKN_AVX_TIER
 {
 template<typename T, std::size_t SIZE>
 struct Type_
@@ -45,16 +49,48 @@ struct Type_
     using internal_type = T;
 
     // default operations without avx
-    auto constexpr static add                = [](auto& a, auto& b) { return a + b; };
-    auto constexpr static sub                = [](auto& a, auto& b) { return a - b; };
-    auto constexpr static mul                = [](auto& a, auto& b) { return a * b; };
-    auto constexpr static div                = [](auto& a, auto& b) { return a / b; };
+    auto constexpr static add                = [](auto& a, auto& b) { return T(a + b); };
+    auto constexpr static sub                = [](auto& a, auto& b) { return T(a - b); };
+    auto constexpr static mul                = [](auto& a, auto& b) { return T(a * b); };
+    auto constexpr static div                = [](auto& a, auto& b) { return T(a / b); };
     auto constexpr static store              = [](auto a, auto& b) { return (*a) = b; };
     auto constexpr static set_v              = [](auto& b) { return b; };
     auto const static inline unaligned_load  = [](auto a) { return *a; };
     auto const static inline unaligned_store = [](auto a, auto& b) { return *a = b; };
 
-    auto constexpr static fma = [](auto& a, auto& b, auto& c) { return a * b + c; };
+    auto constexpr static fma  = [](auto& a, auto& b, auto& c) { return T(a * b + c); };
+    auto constexpr static fms  = [](auto& a, auto& b, auto& c) { return T(a * b - c); };
+    auto constexpr static fnma = [](auto& a, auto& b, auto& c) { return T(c - a * b); };
+    auto constexpr static min  = [](auto& a, auto& b) { return a < b ? a : b; }; // b on NaN, as
+    auto constexpr static max  = [](auto& a, auto& b) { return a > b ? a : b; }; // minpd/maxpd
+
+    // integers, saturate clamps the promoted 8/16 bit result
+    auto constexpr static saturate = [](auto const v) {
+        using L = std::numeric_limits<T>;
+        return T(v < L::min() ? L::min() : v > L::max() ? L::max() : v);
+    };
+    auto constexpr static bit_and    = [](auto& a, auto& b) { return T(a & b); };
+    auto constexpr static bit_or     = [](auto& a, auto& b) { return T(a | b); };
+    auto constexpr static bit_xor    = [](auto& a, auto& b) { return T(a ^ b); };
+    auto constexpr static bit_andnot = [](auto& a, auto& b) { return T(~a & b); };
+    auto constexpr static shl        = [](auto& a, int const n) { return T(a << n); };
+    auto constexpr static shr        = [](auto& a, int const n) { return T(a >> n); };
+    auto constexpr static add_sat    = [](auto& a, auto& b) { return saturate(a + b); };
+    auto constexpr static sub_sat    = [](auto& a, auto& b) { return saturate(a - b); };
+
+    // lane masks are bool
+    auto constexpr static lt       = [](auto& a, auto& b) { return a < b; };
+    auto constexpr static le       = [](auto& a, auto& b) { return a <= b; };
+    auto constexpr static gt       = [](auto& a, auto& b) { return a > b; };
+    auto constexpr static ge       = [](auto& a, auto& b) { return a >= b; };
+    auto constexpr static eq       = [](auto& a, auto& b) { return a == b; };
+    auto constexpr static neq      = [](auto& a, auto& b) { return a != b; };
+    auto constexpr static select   = [](bool m, auto& a, auto& b) { return m ? a : b; };
+    auto constexpr static movemask = [](bool m) { return static_cast<unsigned>(m); };
+
+    auto constexpr static gather      = [](auto p, auto& i) { return p[i]; };
+    auto constexpr static scatter     = [](auto p, auto& i, auto& a) { p[i] = a; };
+    auto constexpr static scatter_add = [](auto p, auto& i, auto& a) { p[i] = T(p[i] + a); };
 };
 
 
@@ -67,6 +103,10 @@ struct TypeDAO
     using impl_type                          = Impl;
     using array_t                            = typename Impl::internal_type;
 
+    // lanes may differ from the register's element type (__m128i is long long), return
+    // types are spelled out as auto deduction drops may_alias
+    using lane_t [[gnu::may_alias]] = T;
+
     TypeDAO() noexcept = default;
 
     TypeDAO(array_t&& arr) noexcept
@@ -74,10 +114,13 @@ struct TypeDAO
     {
     }
 
-    auto& operator[](std::size_t i) noexcept { return reinterpret_cast<T*>(&array)[i]; }
-    auto& operator[](std::size_t i) const noexcept { return array[i]; }
-    inline auto& operator()() noexcept { return array; }
-    inline auto& operator()() const noexcept { return array; }
+    lane_t& operator[](std::size_t i) noexcept { return reinterpret_cast<lane_t*>(&array)[i]; }
+    lane_t const& operator[](std::size_t i) const noexcept
+    {
+        return reinterpret_cast<lane_t const*>(&array)[i];
+    }
+    inline array_t& operator()() noexcept { return array; }
+    inline array_t const& operator()() const noexcept { return array; }
     inline auto data() { return array.data(); }
     inline auto data() const { return array.data(); }
 
@@ -85,6 +128,66 @@ struct TypeDAO
 };
 
 
+// rounding for the avx512 *_round ops, exceptions are suppressed as the intrinsics require
+enum class Rounding : int {
+    NEAREST = _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC,
+    DOWN    = _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC,
+    UP      = _MM_FROUND_TO_POS_INF | _MM_FROUND_NO_EXC,
+    ZERO    = _MM_FROUND_TO_ZERO | _MM_FROUND_NO_EXC,
+};
+
+namespace detail
+{
+// signed integer lanes as wide as T, indices for permute
+template<typename T>
+using index_t = std::conditional_t<
+    sizeof(T) == 8, std::int64_t,
+    std::conditional_t<sizeof(T) == 4, std::int32_t,
+                       std::conditional_t<sizeof(T) == 2, std::int16_t, std::int8_t>>>;
+
+// lane by lane gather/scatter, for widths and lanes without the instructions
+template<typename T, typename R, typename I>
+R inline gather_lanes(T const* p, I const& idx) noexcept
+{
+    std::size_t constexpr n = sizeof(R) / sizeof(T);
+    T x[n];
+    index_t<T> ix[n];
+    std::memcpy(ix, &idx, sizeof(R));
+    for (std::size_t i = 0; i < n; ++i)
+        x[i] = p[ix[i]];
+
+    R ret;
+    std::memcpy(&ret, x, sizeof(R));
+    return ret;
+}
+
+// in lane order, so the last of repeated indices wins
+template<typename T, typename R, typename I>
+void inline scatter_lanes(T* p, I const& idx, R const& a) noexcept
+{
+    std::size_t constexpr n = sizeof(R) / sizeof(T);
+    T x[n];
+    index_t<T> ix[n];
+    std::memcpy(x, &a, sizeof(R));
+    std::memcpy(ix, &idx, sizeof(R));
+    for (std::size_t i = 0; i < n; ++i)
+        p[ix[i]] = x[i];
+}
+
+template<typename T, typename R, typename I>
+void inline scatter_add_lanes(T* p, I const& idx, R const& a) noexcept
+{
+    std::size_t constexpr n = sizeof(R) / sizeof(T);
+    T x[n];
+    index_t<T> ix[n];
+    std::memcpy(x, &a, sizeof(R));
+    std::memcpy(ix, &idx, sizeof(R));
+    for (std::size_t i = 0; i < n; ++i)
+        p[ix[i]] = static_cast<T>(p[ix[i]] + x[i]);
+}
+} // namespace detail
+
+
 //////////////////// double ////////////////////
 template<>
 struct Type_<double, 2>
@@ -95,10 +198,77 @@ struct Type_<double, 2>
     auto const static inline mul             = [](auto&&... v) { return _mm_mul_pd(v...); };
     auto const static inline div             = [](auto&&... v) { return _mm_div_pd(v...); };
     auto const static inline store           = [](auto&&... v) { return _mm_store_pd(v...); };
+    auto const static inline stream          = [](auto&&... v) { return _mm_stream_pd(v...); };
     auto const static inline set_v           = [](auto&&... v) { return _mm_set1_pd(v...); };
-    auto const static inline fma             = [](auto&&... v) { return _mm_fmadd_pd(v...); };
     auto const static inline unaligned_load  = [](auto&&... v) { return _mm_loadu_pd(v...); };
     auto const static inline unaligned_store = [](auto&&... v) { return _mm_storeu_pd(v...); };
+    auto const static inline min             = [](auto&&... v) { return _mm_min_pd(v...); };
+    auto const static inline max             = [](auto&&... v) { return _mm_max_pd(v...); };
+#if MKN_AVX_FMA_ACTIVE
+    auto const static inline fma  = [](auto&&... v) { return _mm_fmadd_pd(v...); };
+    auto const static inline fms  = [](auto&&... v) { return _mm_fmsub_pd(v...); };
+    auto const static inline fnma = [](auto&&... v) { return _mm_fnmadd_pd(v...); };
+#else // -mavx without -mfma, the product is rounded before the add
+    auto const static inline fma
+        = [](auto const& a, auto const& b, auto const& c) { return add(mul(a, b), c); };
+    auto const static inline fms
+        = [](auto const& a, auto const& b, auto const& c) { return sub(mul(a, b), c); };
+    auto const static inline fnma
+        = [](auto const& a, auto const& b, auto const& c) { return sub(c, mul(a, b)); };
+#endif
+
+    // first n lanes, n < SIZE
+    auto const static inline mask = [](auto const n) {
+        return _mm_cmpgt_epi64(_mm_set1_epi64x(n), _mm_set_epi64x(1, 0));
+    };
+    auto const static inline masked_load
+        = [](auto p, auto const n) { return _mm_maskload_pd(p, mask(n)); };
+    auto const static inline masked_fill = [](auto const& a, auto const n, auto const v) {
+        return _mm_blendv_pd(_mm_set1_pd(v), a, _mm_castsi128_pd(mask(n)));
+    };
+    auto const static inline masked_store
+        = [](auto p, auto v, auto const n) { _mm_maskstore_pd(p, mask(n), v); };
+
+    auto const static inline sqrt  = [](auto&&... v) { return _mm_sqrt_pd(v...); };
+    auto const static inline floor = [](auto const& a) { return _mm_floor_pd(a); };
+    auto const static inline round = [](auto const& a) {
+        return _mm_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    };
+    auto const static inline bit_and = [](auto&&... v) { return _mm_and_pd(v...); };
+    auto const static inline bit_xor = [](auto&&... v) { return _mm_xor_pd(v...); };
+
+    // lane masks, neq is true for NaN - select(m, a, b) is m ? a : b
+    //   movemask is one bit per lane, lane 0 the lowest
+    auto const static inline lt
+        = [](auto const& a, auto const& b) { return _mm_cmp_pd(a, b, _CMP_LT_OQ); };
+    auto const static inline eq
+        = [](auto const& a, auto const& b) { return _mm_cmp_pd(a, b, _CMP_EQ_OQ); };
+    auto const static inline neq
+        = [](auto const& a, auto const& b) { return _mm_cmp_pd(a, b, _CMP_NEQ_UQ); };
+    auto const static inline le
+        = [](auto const& a, auto const& b) { return _mm_cmp_pd(a, b, _CMP_LE_OQ); };
+    auto const static inline gt
+        = [](auto const& a, auto const& b) { return _mm_cmp_pd(a, b, _CMP_GT_OQ); };
+    auto const static inline ge
+        = [](auto const& a, auto const& b) { return _mm_cmp_pd(a, b, _CMP_GE_OQ); };
+    auto const static inline movemask
+        = [](auto const& m) { return static_cast<unsigned>(_mm_movemask_pd(m)); };
+
+    // lane i is p[idx[i]], idx lanes as wide as T - scatter is avx512 so goes lane by lane
+    auto const static inline gather = [](auto p, auto const idx) {
+#if defined(__AVX2__)
+        return _mm_i64gather_pd(p, idx, 8);
+#else
+        return detail::gather_lanes<double, __m128d>(p, idx);
+#endif
+    };
+    auto const static inline scatter
+        = [](auto p, auto const idx, auto const& a) { detail::scatter_lanes<double>(p, idx, a); };
+    auto const static inline scatter_add = [](auto p, auto const idx, auto const& a) {
+        detail::scatter_add_lanes<double>(p, idx, a);
+    };
+    auto const static inline select
+        = [](auto const& m, auto const& a, auto const& b) { return _mm_blendv_pd(b, a, m); };
 };
 
 template<>
@@ -110,11 +280,71 @@ struct Type_<double, 4>
     auto const static inline mul             = [](auto&&... v) { return _mm256_mul_pd(v...); };
     auto const static inline div             = [](auto&&... v) { return _mm256_div_pd(v...); };
     auto const static inline store           = [](auto&&... v) { return _mm256_store_pd(v...); };
+    auto const static inline stream          = [](auto&&... v) { return _mm256_stream_pd(v...); };
     auto const static inline set_v           = [](auto&&... v) { return _mm256_set1_pd(v...); };
     auto const static inline unaligned_load  = [](auto&&... v) { return _mm256_loadu_pd(v...); };
     auto const static inline unaligned_store = [](auto&&... v) { return _mm256_storeu_pd(v...); };
+    auto const static inline min             = [](auto&&... v) { return _mm256_min_pd(v...); };
+    auto const static inline max             = [](auto&&... v) { return _mm256_max_pd(v...); };
+#if MKN_AVX_FMA_ACTIVE
+    auto const static inline fma  = [](auto&&... v) { return _mm256_fmadd_pd(v...); };
+    auto const static inline fms  = [](auto&&... v) { return _mm256_fmsub_pd(v...); };
+    auto const static inline fnma = [](auto&&... v) { return _mm256_fnmadd_pd(v...); };
+#else // -mavx without -mfma, the product is rounded before the add
+    auto const static inline fma
+        = [](auto const& a, auto const& b, auto const& c) { return add(mul(a, b), c); };
+    auto const static inline fms
+        = [](auto const& a, auto const& b, auto const& c) { return sub(mul(a, b), c); };
+    auto const static inline fnma
+        = [](auto const& a, auto const& b, auto const& c) { return sub(c, mul(a, b)); };
+#endif
+
+    auto const static inline mask = [](auto const n) {
+        return _mm256_cmpgt_epi64(_mm256_set1_epi64x(n), _mm256_set_epi64x(3, 2, 1, 0));
+    };
+    auto const static inline masked_load
+        = [](auto p, auto const n) { return _mm256_maskload_pd(p, mask(n)); };
+    auto const static inline masked_fill = [](auto const& a, auto const n, auto const v) {
+        return _mm256_blendv_pd(_mm256_set1_pd(v), a, _mm256_castsi256_pd(mask(n)));
+    };
+    auto const static inline masked_store
+        = [](auto p, auto v, auto const n) { _mm256_maskstore_pd(p, mask(n), v); };
+
+    auto const static inline sqrt  = [](auto&&... v) { return _mm256_sqrt_pd(v...); };
+    auto const static inline floor = [](auto const& a) { return _mm256_floor_pd(a); };
+    auto const static inline round = [](auto const& a) {
+        return _mm256_round_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    };
+    auto const static inline bit_and = [](auto&&... v) { return _mm256_and_pd(v...); };
+    auto const static inline bit_xor = [](auto&&... v) { return _mm256_xor_pd(v...); };
+
+    // lane masks, neq is true for NaN - select(m, a, b) is m ? a : b
+    //   movemask is one bit per lane, lane 0 the lowest
+    auto const static inline lt
+        = [](auto const& a, auto const& b) { return _mm256_cmp_pd(a, b, _CMP_LT_OQ); };
+    auto const static inline eq
+        = [](auto const& a, auto const& b) { return _mm256_cmp_pd(a, b, _CMP_EQ_OQ); };
+    auto const static inline neq
+        = [](auto const& a, auto const& b) { return _mm256_cmp_pd(a, b, _CMP_NEQ_UQ); };
+    auto const static inline le
+        = [](auto const& a, auto const& b) { return _mm256_cmp_pd(a, b, _CMP_LE_OQ); };
+    auto const static inline gt
+        = [](auto const& a, auto const& b) { return _mm256_cmp_pd(a, b, _CMP_GT_OQ); };
+    auto const static inline ge
+        = [](auto const& a, auto const& b) { return _mm256_cmp_pd(a, b, _CMP_GE_OQ); };
+    auto const static inline movemask
+        = [](auto const& m) { return static_cast<unsigned>(_mm256_movemask_pd(m)); };
 
-    auto const static inline fma = _mm256_fmadd_pd;
+    // lane i is p[idx[i]], idx lanes as wide as T - scatter is avx512 so goes lane by lane
+    auto const static inline gather
+        = [](auto p, auto const idx) { return _mm256_i64gather_pd(p, idx, 8); };
+    auto const static inline scatter
+        = [](auto p, auto const idx, auto const& a) { detail::scatter_lanes<double>(p, idx, a); };
+    auto const static inline scatter_add = [](auto p, auto const idx, auto const& a) {
+        detail::scatter_add_lanes<double>(p, idx, a);
+    };
+    auto const static inline select
+        = [](auto const& m, auto const& a, auto const& b) { return _mm256_blendv_pd(b, a, m); };
 };
 
 template<>
@@ -126,10 +356,129 @@ struct Type_<double, 8>
     auto const static inline mul             = [](auto&&... v) { return _mm512_mul_pd(v...); };
     auto const static inline div             = [](auto&&... v) { return _mm512_div_pd(v...); };
     auto const static inline store           = [](auto&&... v) { return _mm512_store_pd(v...); };
+    auto const static inline stream          = [](auto&&... v) { return _mm512_stream_pd(v...); };
     auto const static inline set_v           = [](auto&&... v) { return _mm512_set1_pd(v...); };
     auto const static inline unaligned_load  = [](auto&&... v) { return _mm512_loadu_pd(v...); };
     auto const static inline unaligned_store = [](auto&&... v) { return _mm512_storeu_pd(v...); };
-    // auto const static inline fma = _mm256_fmadd_pd;
+    auto const static inline min             = [](auto&&... v) { return _mm512_min_pd(v...); };
+    auto const static inline max             = [](auto&&... v) { return _mm512_max_pd(v...); };
+    auto const static inline fms             = [](auto&&... v) { return _mm512_fmsub_pd(v...); };
+    auto const static inline fnma            = [](auto&&... v) { return _mm512_fnmadd_pd(v...); };
+    auto const static inline fma             = [](auto&&... v) { return _mm512_fmadd_pd(v...); };
+
+    auto const static inline mask = [](auto const n) { return __mmask8((1u << n) - 1); };
+    auto const static inline masked_load
+        = [](auto p, auto const n) { return _mm512_maskz_loadu_pd(mask(n), p); };
+    auto const static inline masked_fill = [](auto const& a, auto const n, auto const v) {
+        return _mm512_mask_mov_pd(_mm512_set1_pd(v), mask(n), a);
+    };
+    auto const static inline masked_store
+        = [](auto p, auto v, auto const n) { _mm512_mask_storeu_pd(p, mask(n), v); };
+
+    auto const static inline sqrt  = [](auto&&... v) { return _mm512_sqrt_pd(v...); };
+    auto const static inline floor = [](auto const& a) {
+        return _mm512_roundscale_pd(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+    };
+    auto const static inline round = [](auto const& a) {
+        return _mm512_roundscale_pd(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    };
+
+    // and/xor on floating point lanes are avx512dq, go through the integer ops
+    auto const static inline bit_and = [](auto const& a, auto const& b) {
+        auto const i = _mm512_and_si512(_mm512_castpd_si512(a), _mm512_castpd_si512(b));
+        return _mm512_castsi512_pd(i);
+    };
+    auto const static inline bit_xor = [](auto const& a, auto const& b) {
+        auto const i = _mm512_xor_si512(_mm512_castpd_si512(a), _mm512_castpd_si512(b));
+        return _mm512_castsi512_pd(i);
+    };
+
+    // lane masks, neq is true for NaN - select(m, a, b) is m ? a : b
+    //   movemask is one bit per lane, lane 0 the lowest
+    auto const static inline lt
+        = [](auto const& a, auto const& b) { return _mm512_cmp_pd_mask(a, b, _CMP_LT_OQ); };
+    auto const static inline eq
+        = [](auto const& a, auto const& b) { return _mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); };
+    auto const static inline neq
+        = [](auto const& a, auto const& b) { return _mm512_cmp_pd_mask(a, b, _CMP_NEQ_UQ); };
+    auto const static inline le
+        = [](auto const& a, auto const& b) { return _mm512_cmp_pd_mask(a, b, _CMP_LE_OQ); };
+    auto const static inline gt
+        = [](auto const& a, auto const& b) { return _mm512_cmp_pd_mask(a, b, _CMP_GT_OQ); };
+    auto const static inline ge
+        = [](auto const& a, auto const& b) { return _mm512_cmp_pd_mask(a, b, _CMP_GE_OQ); };
+    auto const static inline movemask = [](auto const m) { return static_cast<unsigned>(m); };
+
+    // lane i is p[idx[i]], idx lanes as wide as T
+    //   scatter writes in lane order so the last of repeated indices wins, scatter_add
+    //   accumulates repeats, the avx512cd conflict mask lets each round update the
+    //   first pending lane of every index
+    auto const static inline gather
+        = [](auto p, auto const idx) { return _mm512_i64gather_pd(idx, p, 8); };
+    auto const static inline scatter = [](auto p, auto const idx, auto const& a) {
+        _mm512_i64scatter_pd(p, idx, a, 8);
+    };
+    auto const static inline scatter_add = [](auto p, auto const idx, auto const& a) {
+#if defined(__AVX512CD__)
+        auto const conflicts = _mm512_conflict_epi64(idx);
+        for (__mmask8 todo = static_cast<__mmask8>(~0u); todo;)
+        {
+            auto const pending = _mm512_set1_epi64(todo);
+            auto const ready   = _mm512_mask_testn_epi64_mask(todo, conflicts, pending);
+            auto const v = _mm512_mask_i64gather_pd(a, ready, idx, p, 8);
+            _mm512_mask_i64scatter_pd(p, ready, idx, _mm512_add_pd(v, a), 8);
+            todo = static_cast<__mmask8>(todo & ~ready);
+        }
+#else
+        detail::scatter_add_lanes<double>(p, idx, a);
+#endif
+    };
+    auto const static inline select
+        = [](auto const& m, auto const& a, auto const& b) { return _mm512_mask_blend_pd(m, b, a); };
+
+    // avx512 only
+    //   compress packs the lanes set in m to the front, expand is the inverse
+    //   permute(idx, a) is a[idx[i]] for each lane i
+    //   mask_op(src, m, a, b) is m ? op(a, b) : src per lane
+    //   the *_round ops take a std::integral_constant<Rounding, R>
+    using mask_t = __mmask8;
+    auto const static inline compress
+        = [](auto const m, auto const& a) { return _mm512_maskz_compress_pd(m, a); };
+    auto const static inline expand
+        = [](auto const m, auto const& a) { return _mm512_maskz_expand_pd(m, a); };
+    auto const static inline compress_store
+        = [](auto p, auto const m, auto const& a) { _mm512_mask_compressstoreu_pd(p, m, a); };
+    auto const static inline permute
+        = [](auto const idx, auto const& a) { return _mm512_permutexvar_pd(idx, a); };
+    auto const static inline ternarylogic = [](auto const a, auto const b, auto const c, auto i) {
+        auto const r = _mm512_ternarylogic_epi64(_mm512_castpd_si512(a), _mm512_castpd_si512(b),
+                                                 _mm512_castpd_si512(c), decltype(i)::value);
+        return _mm512_castsi512_pd(r);
+    };
+
+    auto const static inline mask_add = [](auto&&... v) { return _mm512_mask_add_pd(v...); };
+    auto const static inline mask_sub = [](auto&&... v) { return _mm512_mask_sub_pd(v...); };
+    auto const static inline mask_mul = [](auto&&... v) { return _mm512_mask_mul_pd(v...); };
+    auto const static inline mask_div = [](auto&&... v) { return _mm512_mask_div_pd(v...); };
+
+    auto const static inline add_round = [](auto const& a, auto const& b, auto r) {
+        return _mm512_add_round_pd(a, b, static_cast<int>(decltype(r)::value));
+    };
+    auto const static inline sub_round = [](auto const& a, auto const& b, auto r) {
+        return _mm512_sub_round_pd(a, b, static_cast<int>(decltype(r)::value));
+    };
+    auto const static inline mul_round = [](auto const& a, auto const& b, auto r) {
+        return _mm512_mul_round_pd(a, b, static_cast<int>(decltype(r)::value));
+    };
+    auto const static inline div_round = [](auto const& a, auto const& b, auto r) {
+        return _mm512_div_round_pd(a, b, static_cast<int>(decltype(r)::value));
+    };
+    auto const static inline fma_round = [](auto const& a, auto const& b, auto const& c, auto r) {
+        return _mm512_fmadd_round_pd(a, b, c, static_cast<int>(decltype(r)::value));
+    };
+    auto const static inline sqrt_round = [](auto const& a, auto r) {
+        return _mm512_sqrt_round_pd(a, static_cast<int>(decltype(r)::value));
+    };
 };
 //////////////////// double ////////////////////
 
@@ -146,10 +495,76 @@ struct Type_<float, 4>
     auto const static inline mul             = [](auto&&... v) { return _mm_mul_ps(v...); };
     auto const static inline div             = [](auto&&... v) { return _mm_div_ps(v...); };
     auto const static inline store           = [](auto&&... v) { return _mm_store_ps(v...); };
+    auto const static inline stream          = [](auto&&... v) { return _mm_stream_ps(v...); };
     auto const static inline set_v           = [](auto&&... v) { return _mm_set1_ps(v...); };
-    auto const static inline fma             = [](auto&&... v) { return _mm_fmadd_ps(v...); };
     auto const static inline unaligned_load  = [](auto&&... v) { return _mm_loadu_ps(v...); };
     auto const static inline unaligned_store = [](auto&&... v) { return _mm_storeu_ps(v...); };
+    auto const static inline min             = [](auto&&... v) { return _mm_min_ps(v...); };
+    auto const static inline max             = [](auto&&... v) { return _mm_max_ps(v...); };
+#if MKN_AVX_FMA_ACTIVE
+    auto const static inline fma  = [](auto&&... v) { return _mm_fmadd_ps(v...); };
+    auto const static inline fms  = [](auto&&... v) { return _mm_fmsub_ps(v...); };
+    auto const static inline fnma = [](auto&&... v) { return _mm_fnmadd_ps(v...); };
+#else // -mavx without -mfma, the product is rounded before the add
+    auto const static inline fma
+        = [](auto const& a, auto const& b, auto const& c) { return add(mul(a, b), c); };
+    auto const static inline fms
+        = [](auto const& a, auto const& b, auto const& c) { return sub(mul(a, b), c); };
+    auto const static inline fnma
+        = [](auto const& a, auto const& b, auto const& c) { return sub(c, mul(a, b)); };
+#endif
+
+    auto const static inline mask = [](auto const n) {
+        return _mm_cmpgt_epi32(_mm_set1_epi32(n), _mm_setr_epi32(0, 1, 2, 3));
+    };
+    auto const static inline masked_load
+        = [](auto p, auto const n) { return _mm_maskload_ps(p, mask(n)); };
+    auto const static inline masked_fill = [](auto const& a, auto const n, auto const v) {
+        return _mm_blendv_ps(_mm_set1_ps(v), a, _mm_castsi128_ps(mask(n)));
+    };
+    auto const static inline masked_store
+        = [](auto p, auto v, auto const n) { _mm_maskstore_ps(p, mask(n), v); };
+
+    auto const static inline sqrt  = [](auto&&... v) { return _mm_sqrt_ps(v...); };
+    auto const static inline floor = [](auto const& a) { return _mm_floor_ps(a); };
+    auto const static inline round = [](auto const& a) {
+        return _mm_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    };
+    auto const static inline bit_and = [](auto&&... v) { return _mm_and_ps(v...); };
+    auto const static inline bit_xor = [](auto&&... v) { return _mm_xor_ps(v...); };
+
+    // lane masks, neq is true for NaN - select(m, a, b) is m ? a : b
+    //   movemask is one bit per lane, lane 0 the lowest
+    auto const static inline lt
+        = [](auto const& a, auto const& b) { return _mm_cmp_ps(a, b, _CMP_LT_OQ); };
+    auto const static inline eq
+        = [](auto const& a, auto const& b) { return _mm_cmp_ps(a, b, _CMP_EQ_OQ); };
+    auto const static inline neq
+        = [](auto const& a, auto const& b) { return _mm_cmp_ps(a, b, _CMP_NEQ_UQ); };
+    auto const static inline le
+        = [](auto const& a, auto const& b) { return _mm_cmp_ps(a, b, _CMP_LE_OQ); };
+    auto const static inline gt
+        = [](auto const& a, auto const& b) { return _mm_cmp_ps(a, b, _CMP_GT_OQ); };
+    auto const static inline ge
+        = [](auto const& a, auto const& b) { return _mm_cmp_ps(a, b, _CMP_GE_OQ); };
+    auto const static inline movemask
+        = [](auto const& m) { return static_cast<unsigned>(_mm_movemask_ps(m)); };
+
+    // lane i is p[idx[i]], idx lanes as wide as T - scatter is avx512 so goes lane by lane
+    auto const static inline gather = [](auto p, auto const idx) {
+#if defined(__AVX2__)
+        return _mm_i32gather_ps(p, idx, 4);
+#else
+        return detail::gather_lanes<float, __m128>(p, idx);
+#endif
+    };
+    auto const static inline scatter
+        = [](auto p, auto const idx, auto const& a) { detail::scatter_lanes<float>(p, idx, a); };
+    auto const static inline scatter_add = [](auto p, auto const idx, auto const& a) {
+        detail::scatter_add_lanes<float>(p, idx, a);
+    };
+    auto const static inline select
+        = [](auto const& m, auto const& a, auto const& b) { return _mm_blendv_ps(b, a, m); };
 };
 
 template<>
@@ -161,10 +576,71 @@ struct Type_<float, 8>
     auto const static inline mul             = [](auto&&... v) { return _mm256_mul_ps(v...); };
     auto const static inline div             = [](auto&&... v) { return _mm256_div_ps(v...); };
     auto const static inline store           = [](auto&&... v) { return _mm256_store_ps(v...); };
+    auto const static inline stream          = [](auto&&... v) { return _mm256_stream_ps(v...); };
     auto const static inline set_v           = [](auto&&... v) { return _mm256_set1_ps(v...); };
-    auto const static inline fma             = [](auto&&... v) { return _mm256_fmadd_ps(v...); };
     auto const static inline unaligned_load  = [](auto&&... v) { return _mm256_loadu_ps(v...); };
     auto const static inline unaligned_store = [](auto&&... v) { return _mm256_storeu_ps(v...); };
+    auto const static inline min             = [](auto&&... v) { return _mm256_min_ps(v...); };
+    auto const static inline max             = [](auto&&... v) { return _mm256_max_ps(v...); };
+#if MKN_AVX_FMA_ACTIVE
+    auto const static inline fma  = [](auto&&... v) { return _mm256_fmadd_ps(v...); };
+    auto const static inline fms  = [](auto&&... v) { return _mm256_fmsub_ps(v...); };
+    auto const static inline fnma = [](auto&&... v) { return _mm256_fnmadd_ps(v...); };
+#else // -mavx without -mfma, the product is rounded before the add
+    auto const static inline fma
+        = [](auto const& a, auto const& b, auto const& c) { return add(mul(a, b), c); };
+    auto const static inline fms
+        = [](auto const& a, auto const& b, auto const& c) { return sub(mul(a, b), c); };
+    auto const static inline fnma
+        = [](auto const& a, auto const& b, auto const& c) { return sub(c, mul(a, b)); };
+#endif
+
+    auto const static inline mask = [](auto const n) {
+        return _mm256_cmpgt_epi32(_mm256_set1_epi32(n), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+    };
+    auto const static inline masked_load
+        = [](auto p, auto const n) { return _mm256_maskload_ps(p, mask(n)); };
+    auto const static inline masked_fill = [](auto const& a, auto const n, auto const v) {
+        return _mm256_blendv_ps(_mm256_set1_ps(v), a, _mm256_castsi256_ps(mask(n)));
+    };
+    auto const static inline masked_store
+        = [](auto p, auto v, auto const n) { _mm256_maskstore_ps(p, mask(n), v); };
+
+    auto const static inline sqrt  = [](auto&&... v) { return _mm256_sqrt_ps(v...); };
+    auto const static inline floor = [](auto const& a) { return _mm256_floor_ps(a); };
+    auto const static inline round = [](auto const& a) {
+        return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    };
+    auto const static inline bit_and = [](auto&&... v) { return _mm256_and_ps(v...); };
+    auto const static inline bit_xor = [](auto&&... v) { return _mm256_xor_ps(v...); };
+
+    // lane masks, neq is true for NaN - select(m, a, b) is m ? a : b
+    //   movemask is one bit per lane, lane 0 the lowest
+    auto const static inline lt
+        = [](auto const& a, auto const& b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); };
+    auto const static inline eq
+        = [](auto const& a, auto const& b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); };
+    auto const static inline neq
+        = [](auto const& a, auto const& b) { return _mm256_cmp_ps(a, b, _CMP_NEQ_UQ); };
+    auto const static inline le
+        = [](auto const& a, auto const& b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); };
+    auto const static inline gt
+        = [](auto const& a, auto const& b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); };
+    auto const static inline ge
+        = [](auto const& a, auto const& b) { return _mm256_cmp_ps(a, b, _CMP_GE_OQ); };
+    auto const static inline movemask
+        = [](auto const& m) { return static_cast<unsigned>(_mm256_movemask_ps(m)); };
+
+    // lane i is p[idx[i]], idx lanes as wide as T - scatter is avx512 so goes lane by lane
+    auto const static inline gather
+        = [](auto p, auto const idx) { return _mm256_i32gather_ps(p, idx, 4); };
+    auto const static inline scatter
+        = [](auto p, auto const idx, auto const& a) { detail::scatter_lanes<float>(p, idx, a); };
+    auto const static inline scatter_add = [](auto p, auto const idx, auto const& a) {
+        detail::scatter_add_lanes<float>(p, idx, a);
+    };
+    auto const static inline select
+        = [](auto const& m, auto const& a, auto const& b) { return _mm256_blendv_ps(b, a, m); };
 };
 
 template<>
@@ -176,10 +652,126 @@ struct Type_<float, 16>
     auto const static inline mul             = [](auto&&... v) { return _mm512_mul_ps(v...); };
     auto const static inline div             = [](auto&&... v) { return _mm512_div_ps(v...); };
     auto const static inline store           = [](auto&&... v) { return _mm512_store_ps(v...); };
+    auto const static inline stream          = [](auto&&... v) { return _mm512_stream_ps(v...); };
     auto const static inline set_v           = [](auto&&... v) { return _mm512_set1_ps(v...); };
     auto const static inline fma             = [](auto&&... v) { return _mm512_fmadd_ps(v...); };
     auto const static inline unaligned_load  = [](auto&&... v) { return _mm512_loadu_ps(v...); };
     auto const static inline unaligned_store = [](auto&&... v) { return _mm512_storeu_ps(v...); };
+    auto const static inline min             = [](auto&&... v) { return _mm512_min_ps(v...); };
+    auto const static inline max             = [](auto&&... v) { return _mm512_max_ps(v...); };
+    auto const static inline fms             = [](auto&&... v) { return _mm512_fmsub_ps(v...); };
+    auto const static inline fnma            = [](auto&&... v) { return _mm512_fnmadd_ps(v...); };
+
+    auto const static inline mask = [](auto const n) { return __mmask16((1u << n) - 1); };
+    auto const static inline masked_load
+        = [](auto p, auto const n) { return _mm512_maskz_loadu_ps(mask(n), p); };
+    auto const static inline masked_fill = [](auto const& a, auto const n, auto const v) {
+        return _mm512_mask_mov_ps(_mm512_set1_ps(v), mask(n), a);
+    };
+    auto const static inline masked_store
+        = [](auto p, auto v, auto const n) { _mm512_mask_storeu_ps(p, mask(n), v); };
+
+    auto const static inline sqrt  = [](auto&&... v) { return _mm512_sqrt_ps(v...); };
+    auto const static inline floor = [](auto const& a) {
+        return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC);
+    };
+    auto const static inline round = [](auto const& a) {
+        return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    };
+
+    // and/xor on floating point lanes are avx512dq, go through the integer ops
+    auto const static inline bit_and = [](auto const& a, auto const& b) {
+        auto const i = _mm512_and_si512(_mm512_castps_si512(a), _mm512_castps_si512(b));
+        return _mm512_castsi512_ps(i);
+    };
+    auto const static inline bit_xor = [](auto const& a, auto const& b) {
+        auto const i = _mm512_xor_si512(_mm512_castps_si512(a), _mm512_castps_si512(b));
+        return _mm512_castsi512_ps(i);
+    };
+
+    // lane masks, neq is true for NaN - select(m, a, b) is m ? a : b
+    //   movemask is one bit per lane, lane 0 the lowest
+    auto const static inline lt
+        = [](auto const& a, auto const& b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); };
+    auto const static inline eq
+        = [](auto const& a, auto const& b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); };
+    auto const static inline neq
+        = [](auto const& a, auto const& b) { return _mm512_cmp_ps_mask(a, b, _CMP_NEQ_UQ); };
+    auto const static inline le
+        = [](auto const& a, auto const& b) { return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ); };
+    auto const static inline gt
+        = [](auto const& a, auto const& b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); };
+    auto const static inline ge
+        = [](auto const& a, auto const& b) { return _mm512_cmp_ps_mask(a, b, _CMP_GE_OQ); };
+    auto const static inline movemask = [](auto const m) { return static_cast<unsigned>(m); };
+
+    // see Type_<double, 8>
+    auto const static inline gather
+        = [](auto p, auto const idx) { return _mm512_i32gather_ps(idx, p, 4); };
+    auto const static inline scatter = [](auto p, auto const idx, auto const& a) {
+        _mm512_i32scatter_ps(p, idx, a, 4);
+    };
+    auto const static inline scatter_add = [](auto p, auto const idx, auto const& a) {
+#if defined(__AVX512CD__)
+        auto const conflicts = _mm512_conflict_epi32(idx);
+        for (__mmask16 todo = static_cast<__mmask16>(~0u); todo;)
+        {
+            auto const pending = _mm512_set1_epi32(todo);
+            auto const ready   = _mm512_mask_testn_epi32_mask(todo, conflicts, pending);
+            auto const v = _mm512_mask_i32gather_ps(a, ready, idx, p, 4);
+            _mm512_mask_i32scatter_ps(p, ready, idx, _mm512_add_ps(v, a), 4);
+            todo = static_cast<__mmask16>(todo & ~ready);
+        }
+#else
+        detail::scatter_add_lanes<float>(p, idx, a);
+#endif
+    };
+    auto const static inline select
+        = [](auto const& m, auto const& a, auto const& b) { return _mm512_mask_blend_ps(m, b, a); };
+
+    // avx512 only
+    //   compress packs the lanes set in m to the front, expand is the inverse
+    //   permute(idx, a) is a[idx[i]] for each lane i
+    //   mask_op(src, m, a, b) is m ? op(a, b) : src per lane
+    //   the *_round ops take a std::integral_constant<Rounding, R>
+    using mask_t = __mmask16;
+    auto const static inline compress
+        = [](auto const m, auto const& a) { return _mm512_maskz_compress_ps(m, a); };
+    auto const static inline expand
+        = [](auto const m, auto const& a) { return _mm512_maskz_expand_ps(m, a); };
+    auto const static inline compress_store
+        = [](auto p, auto const m, auto const& a) { _mm512_mask_compressstoreu_ps(p, m, a); };
+    auto const static inline permute
+        = [](auto const idx, auto const& a) { return _mm512_permutexvar_ps(idx, a); };
+    auto const static inline ternarylogic = [](auto const a, auto const b, auto const c, auto i) {
+        auto const r = _mm512_ternarylogic_epi32(_mm512_castps_si512(a), _mm512_castps_si512(b),
+                                                 _mm512_castps_si512(c), decltype(i)::value);
+        return _mm512_castsi512_ps(r);
+    };
+
+    auto const static inline mask_add = [](auto&&... v) { return _mm512_mask_add_ps(v...); };
+    auto const static inline mask_sub = [](auto&&... v) { return _mm512_mask_sub_ps(v...); };
+    auto const static inline mask_mul = [](auto&&... v) { return _mm512_mask_mul_ps(v...); };
+    auto const static inline mask_div = [](auto&&... v) { return _mm512_mask_div_ps(v...); };
+
+    auto const static inline add_round = [](auto const& a, auto const& b, auto r) {
+        return _mm512_add_round_ps(a, b, static_cast<int>(decltype(r)::value));
+    };
+    auto const static inline sub_round = [](auto const& a, auto const& b, auto r) {
+        return _mm512_sub_round_ps(a, b, static_cast<int>(decltype(r)::value));
+    };
+    auto const static inline mul_round = [](auto const& a, auto const& b, auto r) {
+        return _mm512_mul_round_ps(a, b, static_cast<int>(decltype(r)::value));
+    };
+    auto const static inline div_round = [](auto const& a, auto const& b, auto r) {
+        return _mm512_div_round_ps(a, b, static_cast<int>(decltype(r)::value));
+    };
+    auto const static inline fma_round = [](auto const& a, auto const& b, auto const& c, auto r) {
+        return _mm512_fmadd_round_ps(a, b, c, static_cast<int>(decltype(r)::value));
+    };
+    auto const static inline sqrt_round = [](auto const& a, auto r) {
+        return _mm512_sqrt_round_ps(a, static_cast<int>(decltype(r)::value));
+    };
 };
 
 //////////////////// float ////////////////////
@@ -187,72 +779,960 @@ struct Type_<float, 16>
 
 
 
-//////////////////// std::int16_t ////////////////////
-template<>
-struct Type_<std::int16_t, 4>
+//////////////////// integers ////////////////////
+namespace detail
+{
+// lane by lane, for what has no integer instruction (division)
+template<typename T, typename R, typename Fn>
+R inline lanewise(R const& a, R const& b, Fn const& fn) noexcept
+{
+    std::size_t constexpr n = sizeof(R) / sizeof(T);
+    T x[n], y[n];
+    std::memcpy(x, &a, sizeof(R));
+    std::memcpy(y, &b, sizeof(R));
+    for (std::size_t i = 0; i < n; ++i)
+        x[i] = static_cast<T>(fn(x[i], y[i]));
+
+    R ret;
+    std::memcpy(&ret, x, sizeof(R));
+    return ret;
+}
+
+// lane by lane compress/expand/permute, for where the instruction is a later extension
+template<typename T, typename R, typename M>
+R inline compress_lanes(M const m, R const& a) noexcept
+{
+    std::size_t constexpr n = sizeof(R) / sizeof(T);
+    T x[n], r[n]{};
+    std::memcpy(x, &a, sizeof(R));
+    for (std::size_t i = 0, j = 0; i < n; ++i)
+        if ((m >> i) & 1)
+            r[j++] = x[i];
+
+    R ret;
+    std::memcpy(&ret, r, sizeof(R));
+    return ret;
+}
+
+template<typename T, typename R, typename M>
+R inline expand_lanes(M const m, R const& a) noexcept
+{
+    std::size_t constexpr n = sizeof(R) / sizeof(T);
+    T x[n], r[n]{};
+    std::memcpy(x, &a, sizeof(R));
+    for (std::size_t i = 0, j = 0; i < n; ++i)
+        if ((m >> i) & 1)
+            r[i] = x[j++];
+
+    R ret;
+    std::memcpy(&ret, r, sizeof(R));
+    return ret;
+}
+
+template<typename T, typename R>
+R inline permute_lanes(R const& idx, R const& a) noexcept
 {
-    using internal_type          = __m128i;
-    auto const static inline add = [](auto&&... v) { return _mm_add_epi16(v...); };
-    auto const static inline sub = [](auto&&... v) { return _mm_sub_epi16(v...); };
-    // auto const static inline mul = _mm_mul_epi16;
-    // auto const static inline fma = _mm256_fmadd_ps;
+    std::size_t constexpr n = sizeof(R) / sizeof(T);
+    T x[n], ix[n];
+    std::memcpy(x, &a, sizeof(R));
+    std::memcpy(ix, &idx, sizeof(R));
+    for (std::size_t i = 0; i < n; ++i)
+        ix[i] = x[static_cast<std::size_t>(ix[i]) % n];
+
+    R ret;
+    std::memcpy(&ret, ix, sizeof(R));
+    return ret;
+}
+
+template<typename T>
+bool constexpr is_lane_int_v = std::is_integral_v<T> and !std::is_same_v<T, bool>;
+} // namespace detail
+
+// one implementation per register width, the lane type picks the instructions
+//   x86 has no 8 bit multiply or shift, nor a 64 bit arithmetic shift or min/max
+//   before avx512, those are built from the wider/narrower lane ops
+//   shift counts must be less than the lane width
+//   bit_andnot(a, b) is ~a & b
+//   add_sat/sub_sat are 8 and 16 bit lanes only, which at 512 bits need avx512bw
+//   registers are taken by value, deducing a reference drops the may_alias on
+//   __m128i and friends, after which loads are assumed not to alias T
+template<typename T, std::size_t BITS>
+struct Int_;
+
+template<typename T>
+struct Int_<T, 128>
+{
+    using internal_type               = __m128i;
+    using U                           = std::make_unsigned_t<T>;
+    std::size_t static constexpr bits = sizeof(T) * 8;
+
+    auto const static inline bit_and
+        = [](auto const a, auto const b) { return _mm_and_si128(a, b); };
+    auto const static inline bit_or
+        = [](auto const a, auto const b) { return _mm_or_si128(a, b); };
+    auto const static inline bit_xor
+        = [](auto const a, auto const b) { return _mm_xor_si128(a, b); };
+    auto const static inline bit_andnot
+        = [](auto const a, auto const b) { return _mm_andnot_si128(a, b); };
+
+    auto const static inline set_v = [](auto const v) {
+        if constexpr (bits == 8)
+            return _mm_set1_epi8(static_cast<char>(v));
+        else if constexpr (bits == 16)
+            return _mm_set1_epi16(static_cast<short>(v));
+        else if constexpr (bits == 32)
+            return _mm_set1_epi32(static_cast<int>(v));
+        else
+            return _mm_set1_epi64x(static_cast<long long>(v));
+    };
+    auto const static inline add = [](auto const a, auto const b) {
+        if constexpr (bits == 8)
+            return _mm_add_epi8(a, b);
+        else if constexpr (bits == 16)
+            return _mm_add_epi16(a, b);
+        else if constexpr (bits == 32)
+            return _mm_add_epi32(a, b);
+        else
+            return _mm_add_epi64(a, b);
+    };
+    auto const static inline sub = [](auto const a, auto const b) {
+        if constexpr (bits == 8)
+            return _mm_sub_epi8(a, b);
+        else if constexpr (bits == 16)
+            return _mm_sub_epi16(a, b);
+        else if constexpr (bits == 32)
+            return _mm_sub_epi32(a, b);
+        else
+            return _mm_sub_epi64(a, b);
+    };
+    auto const static inline mul = [](auto const a, auto const b) {
+        if constexpr (bits == 8)
+        { // even bytes from the low halves, odd bytes from the high halves
+            auto const even = _mm_mullo_epi16(a, b);
+            auto const odd  = _mm_mullo_epi16(_mm_srli_epi16(a, 8), _mm_srli_epi16(b, 8));
+            return bit_or(_mm_slli_epi16(odd, 8), bit_and(even, _mm_set1_epi16(0xff)));
+        }
+        else if constexpr (bits == 16)
+            return _mm_mullo_epi16(a, b);
+        else if constexpr (bits == 32)
+            return _mm_mullo_epi32(a, b);
+        else
+        {
+#if defined(__AVX512DQ__) && defined(__AVX512VL__)
+            return _mm_mullo_epi64(a, b);
+#else // lo * lo + ((hi * lo + lo * hi) << 32)
+            auto const cross = _mm_add_epi64(_mm_mul_epu32(_mm_srli_epi64(a, 32), b),
+                                             _mm_mul_epu32(a, _mm_srli_epi64(b, 32)));
+            return _mm_add_epi64(_mm_mul_epu32(a, b), _mm_slli_epi64(cross, 32));
+#endif
+        }
+    };
+    auto const static inline div = [](auto const a, auto const b) {
+        return detail::lanewise<T>(a, b, [](auto const x, auto const y) { return x / y; });
+    };
+    auto const static inline store = [](auto p, auto const a) {
+        _mm_store_si128(reinterpret_cast<__m128i*>(p), a);
+    };
+    auto const static inline stream = [](auto p, auto const a) {
+        _mm_stream_si128(reinterpret_cast<__m128i*>(p), a);
+    };
+    auto const static inline unaligned_load
+        = [](auto p) { return _mm_loadu_si128(reinterpret_cast<__m128i const*>(p)); };
+    auto const static inline unaligned_store = [](auto p, auto const a) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(p), a);
+    };
+
+    auto const static inline fma  = [](auto const a, auto const b, auto const c) {
+        return add(mul(a, b), c);
+    };
+    auto const static inline fms  = [](auto const a, auto const b, auto const c) {
+        return sub(mul(a, b), c);
+    };
+    auto const static inline fnma = [](auto const a, auto const b, auto const c) {
+        return sub(c, mul(a, b));
+    };
+
+    // lane masks, all ones where true - select(m, a, b) is m ? a : b
+    //   only signed greater than and equality exist, unsigned flips the sign bits
+    //   movemask is one bit per lane, lane 0 the lowest
+    auto const static inline eq = [](auto const a, auto const b) {
+        if constexpr (bits == 8)
+            return _mm_cmpeq_epi8(a, b);
+        else if constexpr (bits == 16)
+            return _mm_cmpeq_epi16(a, b);
+        else if constexpr (bits == 32)
+            return _mm_cmpeq_epi32(a, b);
+        else
+            return _mm_cmpeq_epi64(a, b);
+    };
+    auto const static inline gt = [](auto const a, auto const b) {
+        if constexpr (std::is_unsigned_v<T>)
+        {
+            using SInt   = Int_<std::make_signed_t<T>, 128>;
+            auto const s = SInt::set_v(std::numeric_limits<std::make_signed_t<T>>::min());
+            return SInt::gt(bit_xor(a, s), bit_xor(b, s));
+        }
+        else if constexpr (bits == 8)
+            return _mm_cmpgt_epi8(a, b);
+        else if constexpr (bits == 16)
+            return _mm_cmpgt_epi16(a, b);
+        else if constexpr (bits == 32)
+            return _mm_cmpgt_epi32(a, b);
+        else
+            return _mm_cmpgt_epi64(a, b);
+    };
+    auto const static inline bit_not = [](auto const a) { return bit_xor(a, set_v(-1)); };
+    auto const static inline lt      = [](auto const a, auto const b) { return gt(b, a); };
+    auto const static inline le      = [](auto const a, auto const b) { return bit_not(gt(a, b)); };
+    auto const static inline ge      = [](auto const a, auto const b) { return bit_not(gt(b, a)); };
+    auto const static inline neq     = [](auto const a, auto const b) { return bit_not(eq(a, b)); };
+    auto const static inline select
+        = [](auto const m, auto const a, auto const b) { return _mm_blendv_epi8(b, a, m); };
+    auto const static inline movemask = [](auto const m) {
+        if constexpr (bits == 8)
+            return static_cast<unsigned>(_mm_movemask_epi8(m));
+        else if constexpr (bits == 16)
+            return static_cast<unsigned>(
+                _mm_movemask_epi8(_mm_packs_epi16(m, _mm_setzero_si128())));
+        else if constexpr (bits == 32)
+            return static_cast<unsigned>(_mm_movemask_ps(_mm_castsi128_ps(m)));
+        else
+            return static_cast<unsigned>(_mm_movemask_pd(_mm_castsi128_pd(m)));
+    };
+
+    // lane i is p[idx[i]], idx lanes as wide as T - avx2 gathers 32/64 bit lanes,
+    // the rest and scatter go lane by lane
+    auto const static inline gather = [](auto p, auto const idx) {
+#if defined(__AVX2__)
+        if constexpr (bits == 32)
+            return _mm_i32gather_epi32(reinterpret_cast<int const*>(p), idx, 4);
+        else if constexpr (bits == 64)
+            return _mm_i64gather_epi64(reinterpret_cast<long long const*>(p), idx, 8);
+        else
+            return detail::gather_lanes<T, __m128i>(p, idx);
+#else
+        return detail::gather_lanes<T, __m128i>(p, idx);
+#endif
+    };
+    auto const static inline scatter
+        = [](auto p, auto const idx, auto const a) { detail::scatter_lanes<T>(p, idx, a); };
+    auto const static inline scatter_add
+        = [](auto p, auto const idx, auto const a) { detail::scatter_add_lanes<T>(p, idx, a); };
+
+    auto const static inline min = [](auto const a, auto const b) {
+        if constexpr (bits == 8)
+            return std::is_signed_v<T> ? _mm_min_epi8(a, b) : _mm_min_epu8(a, b);
+        else if constexpr (bits == 16)
+            return std::is_signed_v<T> ? _mm_min_epi16(a, b) : _mm_min_epu16(a, b);
+        else if constexpr (bits == 32)
+            return std::is_signed_v<T> ? _mm_min_epi32(a, b) : _mm_min_epu32(a, b);
+        else
+        {
+#if defined(__AVX512VL__)
+            return std::is_signed_v<T> ? _mm_min_epi64(a, b) : _mm_min_epu64(a, b);
+#else
+            return select(gt(a, b), b, a);
+#endif
+        }
+    };
+    auto const static inline max = [](auto const a, auto const b) {
+        if constexpr (bits == 8)
+            return std::is_signed_v<T> ? _mm_max_epi8(a, b) : _mm_max_epu8(a, b);
+        else if constexpr (bits == 16)
+            return std::is_signed_v<T> ? _mm_max_epi16(a, b) : _mm_max_epu16(a, b);
+        else if constexpr (bits == 32)
+            return std::is_signed_v<T> ? _mm_max_epi32(a, b) : _mm_max_epu32(a, b);
+        else
+        {
+#if defined(__AVX512VL__)
+            return std::is_signed_v<T> ? _mm_max_epi64(a, b) : _mm_max_epu64(a, b);
+#else
+            return select(gt(a, b), a, b);
+#endif
+        }
+    };
+
+    auto const static inline shl = [](auto const a, int const n) {
+        auto const c = _mm_cvtsi32_si128(n);
+        if constexpr (bits == 8)
+            return bit_and(_mm_sll_epi16(a, c), set_v(0xff << n)); // bytes from words
+        else if constexpr (bits == 16)
+            return _mm_sll_epi16(a, c);
+        else if constexpr (bits == 32)
+            return _mm_sll_epi32(a, c);
+        else
+            return _mm_sll_epi64(a, c);
+    };
+    // arithmetic for signed lanes, logical for unsigned
+    auto const static inline shr = [](auto const a, int const n) {
+        auto const c = _mm_cvtsi32_si128(n);
+        if constexpr (std::is_signed_v<T> and bits == 16)
+            return _mm_sra_epi16(a, c);
+        else if constexpr (std::is_signed_v<T> and bits == 32)
+            return _mm_sra_epi32(a, c);
+#if defined(__AVX512VL__)
+        else if constexpr (std::is_signed_v<T> and bits == 64)
+            return _mm_sra_epi64(a, c);
+#endif
+        else if constexpr (std::is_signed_v<T>)
+        { // sign extend the logical shift, (x >> n ^ m) - m with m the shifted sign bit.
+          // not through Int_<U>, whose gt needs this type complete
+            __m128i x;
+            if constexpr (bits == 8)
+                x = bit_and(_mm_srl_epi16(a, c), set_v(static_cast<T>(0xff >> n)));
+            else
+                x = _mm_srl_epi64(a, c);
+            auto const m = set_v(static_cast<T>(static_cast<U>(U{1} << (bits - 1)) >> n));
+            return sub(bit_xor(x, m), m);
+        }
+        else if constexpr (bits == 8)
+            return bit_and(_mm_srl_epi16(a, c), set_v(0xff >> n));
+        else if constexpr (bits == 16)
+            return _mm_srl_epi16(a, c);
+        else if constexpr (bits == 32)
+            return _mm_srl_epi32(a, c);
+        else
+            return _mm_srl_epi64(a, c);
+    };
+
+    auto const static inline add_sat = [](auto const a, auto const b) {
+        if constexpr (bits == 8)
+            return std::is_signed_v<T> ? _mm_adds_epi8(a, b) : _mm_adds_epu8(a, b);
+        else if constexpr (bits == 16)
+            return std::is_signed_v<T> ? _mm_adds_epi16(a, b) : _mm_adds_epu16(a, b);
+    };
+    auto const static inline sub_sat = [](auto const a, auto const b) {
+        if constexpr (bits == 8)
+            return std::is_signed_v<T> ? _mm_subs_epi8(a, b) : _mm_subs_epu8(a, b);
+        else if constexpr (bits == 16)
+            return std::is_signed_v<T> ? _mm_subs_epi16(a, b) : _mm_subs_epu16(a, b);
+    };
 };
-template<>
-struct Type_<std::int16_t, 8>
+
+template<typename T>
+struct Int_<T, 256>
 {
-    using internal_type          = __m256i;
-    auto const static inline add = [](auto&&... v) { return _mm256_add_epi16(v...); };
-    auto const static inline sub = [](auto&&... v) { return _mm256_sub_epi16(v...); };
-    // auto const static inline mul = _mm256_mul_epi16;
-    // auto const static inline fma = _mm256_fmadd_ps;
+    using internal_type               = __m256i;
+    using U                           = std::make_unsigned_t<T>;
+    std::size_t static constexpr bits = sizeof(T) * 8;
+
+    auto const static inline bit_and
+        = [](auto const a, auto const b) { return _mm256_and_si256(a, b); };
+    auto const static inline bit_or
+        = [](auto const a, auto const b) { return _mm256_or_si256(a, b); };
+    auto const static inline bit_xor
+        = [](auto const a, auto const b) { return _mm256_xor_si256(a, b); };
+    auto const static inline bit_andnot
+        = [](auto const a, auto const b) { return _mm256_andnot_si256(a, b); };
+
+    auto const static inline set_v = [](auto const v) {
+        if constexpr (bits == 8)
+            return _mm256_set1_epi8(static_cast<char>(v));
+        else if constexpr (bits == 16)
+            return _mm256_set1_epi16(static_cast<short>(v));
+        else if constexpr (bits == 32)
+            return _mm256_set1_epi32(static_cast<int>(v));
+        else
+            return _mm256_set1_epi64x(static_cast<long long>(v));
+    };
+    auto const static inline add = [](auto const a, auto const b) {
+        if constexpr (bits == 8)
+            return _mm256_add_epi8(a, b);
+        else if constexpr (bits == 16)
+            return _mm256_add_epi16(a, b);
+        else if constexpr (bits == 32)
+            return _mm256_add_epi32(a, b);
+        else
+            return _mm256_add_epi64(a, b);
+    };
+    auto const static inline sub = [](auto const a, auto const b) {
+        if constexpr (bits == 8)
+            return _mm256_sub_epi8(a, b);
+        else if constexpr (bits == 16)
+            return _mm256_sub_epi16(a, b);
+        else if constexpr (bits == 32)
+            return _mm256_sub_epi32(a, b);
+        else
+            return _mm256_sub_epi64(a, b);
+    };
+    auto const static inline mul = [](auto const a, auto const b) {
+        if constexpr (bits == 8)
+        { // even bytes from the low halves, odd bytes from the high halves
+            auto const even = _mm256_mullo_epi16(a, b);
+            auto const odd  = _mm256_mullo_epi16(_mm256_srli_epi16(a, 8), _mm256_srli_epi16(b, 8));
+            return bit_or(_mm256_slli_epi16(odd, 8), bit_and(even, _mm256_set1_epi16(0xff)));
+        }
+        else if constexpr (bits == 16)
+            return _mm256_mullo_epi16(a, b);
+        else if constexpr (bits == 32)
+            return _mm256_mullo_epi32(a, b);
+        else
+        {
+#if defined(__AVX512DQ__) && defined(__AVX512VL__)
+            return _mm256_mullo_epi64(a, b);
+#else // lo * lo + ((hi * lo + lo * hi) << 32)
+            auto const cross = _mm256_add_epi64(_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+                                             _mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+            return _mm256_add_epi64(_mm256_mul_epu32(a, b), _mm256_slli_epi64(cross, 32));
+#endif
+        }
+    };
+    auto const static inline div = [](auto const a, auto const b) {
+        return detail::lanewise<T>(a, b, [](auto const x, auto const y) { return x / y; });
+    };
+    auto const static inline store = [](auto p, auto const a) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(p), a);
+    };
+    auto const static inline stream = [](auto p, auto const a) {
+        _mm256_stream_si256(reinterpret_cast<__m256i*>(p), a);
+    };
+    auto const static inline unaligned_load
+        = [](auto p) { return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(p)); };
+    auto const static inline unaligned_store = [](auto p, auto const a) {
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), a);
+    };
+
+    auto const static inline fma  = [](auto const a, auto const b, auto const c) {
+        return add(mul(a, b), c);
+    };
+    auto const static inline fms  = [](auto const a, auto const b, auto const c) {
+        return sub(mul(a, b), c);
+    };
+    auto const static inline fnma = [](auto const a, auto const b, auto const c) {
+        return sub(c, mul(a, b));
+    };
+
+    // lane masks, all ones where true - select(m, a, b) is m ? a : b
+    //   only signed greater than and equality exist, unsigned flips the sign bits
+    //   movemask is one bit per lane, lane 0 the lowest
+    auto const static inline eq = [](auto const a, auto const b) {
+        if constexpr (bits == 8)
+            return _mm256_cmpeq_epi8(a, b);
+        else if constexpr (bits == 16)
+            return _mm256_cmpeq_epi16(a, b);
+        else if constexpr (bits == 32)
+            return _mm256_cmpeq_epi32(a, b);
+        else
+            return _mm256_cmpeq_epi64(a, b);
+    };
+    auto const static inline gt = [](auto const a, auto const b) {
+        if constexpr (std::is_unsigned_v<T>)
+        {
+            using SInt   = Int_<std::make_signed_t<T>, 256>;
+            auto const s = SInt::set_v(std::numeric_limits<std::make_signed_t<T>>::min());
+            return SInt::gt(bit_xor(a, s), bit_xor(b, s));
+        }
+        else if constexpr (bits == 8)
+            return _mm256_cmpgt_epi8(a, b);
+        else if constexpr (bits == 16)
+            return _mm256_cmpgt_epi16(a, b);
+        else if constexpr (bits == 32)
+            return _mm256_cmpgt_epi32(a, b);
+        else
+            return _mm256_cmpgt_epi64(a, b);
+    };
+    auto const static inline bit_not = [](auto const a) { return bit_xor(a, set_v(-1)); };
+    auto const static inline lt      = [](auto const a, auto const b) { return gt(b, a); };
+    auto const static inline le      = [](auto const a, auto const b) { return bit_not(gt(a, b)); };
+    auto const static inline ge      = [](auto const a, auto const b) { return bit_not(gt(b, a)); };
+    auto const static inline neq     = [](auto const a, auto const b) { return bit_not(eq(a, b)); };
+    auto const static inline select
+        = [](auto const m, auto const a, auto const b) { return _mm256_blendv_epi8(b, a, m); };
+    auto const static inline movemask = [](auto const m) {
+        if constexpr (bits == 8)
+            return static_cast<unsigned>(_mm256_movemask_epi8(m));
+        else if constexpr (bits == 16)
+            return static_cast<unsigned>(_mm_movemask_epi8(
+                _mm_packs_epi16(_mm256_castsi256_si128(m), _mm256_extracti128_si256(m, 1))));
+        else if constexpr (bits == 32)
+            return static_cast<unsigned>(_mm256_movemask_ps(_mm256_castsi256_ps(m)));
+        else
+            return static_cast<unsigned>(_mm256_movemask_pd(_mm256_castsi256_pd(m)));
+    };
+
+    // lane i is p[idx[i]], idx lanes as wide as T - avx2 gathers 32/64 bit lanes,
+    // the rest and scatter go lane by lane
+    auto const static inline gather = [](auto p, auto const idx) {
+        if constexpr (bits == 32)
+            return _mm256_i32gather_epi32(reinterpret_cast<int const*>(p), idx, 4);
+        else if constexpr (bits == 64)
+            return _mm256_i64gather_epi64(reinterpret_cast<long long const*>(p), idx, 8);
+        else
+            return detail::gather_lanes<T, __m256i>(p, idx);
+    };
+    auto const static inline scatter
+        = [](auto p, auto const idx, auto const a) { detail::scatter_lanes<T>(p, idx, a); };
+    auto const static inline scatter_add
+        = [](auto p, auto const idx, auto const a) { detail::scatter_add_lanes<T>(p, idx, a); };
+
+    auto const static inline min = [](auto const a, auto const b) {
+        if constexpr (bits == 8)
+            return std::is_signed_v<T> ? _mm256_min_epi8(a, b) : _mm256_min_epu8(a, b);
+        else if constexpr (bits == 16)
+            return std::is_signed_v<T> ? _mm256_min_epi16(a, b) : _mm256_min_epu16(a, b);
+        else if constexpr (bits == 32)
+            return std::is_signed_v<T> ? _mm256_min_epi32(a, b) : _mm256_min_epu32(a, b);
+        else
+        {
+#if defined(__AVX512VL__)
+            return std::is_signed_v<T> ? _mm256_min_epi64(a, b) : _mm256_min_epu64(a, b);
+#else
+            return select(gt(a, b), b, a);
+#endif
+        }
+    };
+    auto const static inline max = [](auto const a, auto const b) {
+        if constexpr (bits == 8)
+            return std::is_signed_v<T> ? _mm256_max_epi8(a, b) : _mm256_max_epu8(a, b);
+        else if constexpr (bits == 16)
+            return std::is_signed_v<T> ? _mm256_max_epi16(a, b) : _mm256_max_epu16(a, b);
+        else if constexpr (bits == 32)
+            return std::is_signed_v<T> ? _mm256_max_epi32(a, b) : _mm256_max_epu32(a, b);
+        else
+        {
+#if defined(__AVX512VL__)
+            return std::is_signed_v<T> ? _mm256_max_epi64(a, b) : _mm256_max_epu64(a, b);
+#else
+            return select(gt(a, b), a, b);
+#endif
+        }
+    };
+
+    auto const static inline shl = [](auto const a, int const n) {
+        auto const c = _mm_cvtsi32_si128(n);
+        if constexpr (bits == 8)
+            return bit_and(_mm256_sll_epi16(a, c), set_v(0xff << n)); // bytes from words
+        else if constexpr (bits == 16)
+            return _mm256_sll_epi16(a, c);
+        else if constexpr (bits == 32)
+            return _mm256_sll_epi32(a, c);
+        else
+            return _mm256_sll_epi64(a, c);
+    };
+    // arithmetic for signed lanes, logical for unsigned
+    auto const static inline shr = [](auto const a, int const n) {
+        auto const c = _mm_cvtsi32_si128(n);
+        if constexpr (std::is_signed_v<T> and bits == 16)
+            return _mm256_sra_epi16(a, c);
+        else if constexpr (std::is_signed_v<T> and bits == 32)
+            return _mm256_sra_epi32(a, c);
+#if defined(__AVX512VL__)
+        else if constexpr (std::is_signed_v<T> and bits == 64)
+            return _mm256_sra_epi64(a, c);
+#endif
+        else if constexpr (std::is_signed_v<T>)
+        { // sign extend the logical shift, (x >> n ^ m) - m with m the shifted sign bit.
+          // not through Int_<U>, whose gt needs this type complete
+            __m256i x;
+            if constexpr (bits == 8)
+                x = bit_and(_mm256_srl_epi16(a, c), set_v(static_cast<T>(0xff >> n)));
+            else
+                x = _mm256_srl_epi64(a, c);
+            auto const m = set_v(static_cast<T>(static_cast<U>(U{1} << (bits - 1)) >> n));
+            return sub(bit_xor(x, m), m);
+        }
+        else if constexpr (bits == 8)
+            return bit_and(_mm256_srl_epi16(a, c), set_v(0xff >> n));
+        else if constexpr (bits == 16)
+            return _mm256_srl_epi16(a, c);
+        else if constexpr (bits == 32)
+            return _mm256_srl_epi32(a, c);
+        else
+            return _mm256_srl_epi64(a, c);
+    };
+
+    auto const static inline add_sat = [](auto const a, auto const b) {
+        if constexpr (bits == 8)
+            return std::is_signed_v<T> ? _mm256_adds_epi8(a, b) : _mm256_adds_epu8(a, b);
+        else if constexpr (bits == 16)
+            return std::is_signed_v<T> ? _mm256_adds_epi16(a, b) : _mm256_adds_epu16(a, b);
+    };
+    auto const static inline sub_sat = [](auto const a, auto const b) {
+        if constexpr (bits == 8)
+            return std::is_signed_v<T> ? _mm256_subs_epi8(a, b) : _mm256_subs_epu8(a, b);
+        else if constexpr (bits == 16)
+            return std::is_signed_v<T> ? _mm256_subs_epi16(a, b) : _mm256_subs_epu16(a, b);
+    };
 };
-//////////////////// std::int16_t ////////////////////
 
+template<typename T>
+struct Int_<T, 512>
+{
+    using internal_type               = __m512i;
+    using U                           = std::make_unsigned_t<T>;
+    std::size_t static constexpr bits = sizeof(T) * 8;
 
+    auto const static inline bit_and
+        = [](auto const a, auto const b) { return _mm512_and_si512(a, b); };
+    auto const static inline bit_or
+        = [](auto const a, auto const b) { return _mm512_or_si512(a, b); };
+    auto const static inline bit_xor
+        = [](auto const a, auto const b) { return _mm512_xor_si512(a, b); };
+    auto const static inline bit_andnot
+        = [](auto const a, auto const b) { return _mm512_andnot_si512(a, b); };
 
+    auto const static inline set_v = [](auto const v) {
+        if constexpr (bits == 8)
+            return _mm512_set1_epi8(static_cast<char>(v));
+        else if constexpr (bits == 16)
+            return _mm512_set1_epi16(static_cast<short>(v));
+        else if constexpr (bits == 32)
+            return _mm512_set1_epi32(static_cast<int>(v));
+        else
+            return _mm512_set1_epi64(static_cast<long long>(v));
+    };
+    auto const static inline add = [](auto const a, auto const b) {
+        if constexpr (bits == 8)
+            return _mm512_add_epi8(a, b);
+        else if constexpr (bits == 16)
+            return _mm512_add_epi16(a, b);
+        else if constexpr (bits == 32)
+            return _mm512_add_epi32(a, b);
+        else
+            return _mm512_add_epi64(a, b);
+    };
+    auto const static inline sub = [](auto const a, auto const b) {
+        if constexpr (bits == 8)
+            return _mm512_sub_epi8(a, b);
+        else if constexpr (bits == 16)
+            return _mm512_sub_epi16(a, b);
+        else if constexpr (bits == 32)
+            return _mm512_sub_epi32(a, b);
+        else
+            return _mm512_sub_epi64(a, b);
+    };
+    auto const static inline mul = [](auto const a, auto const b) {
+        if constexpr (bits == 8)
+        { // even bytes from the low halves, odd bytes from the high halves
+            auto const even = _mm512_mullo_epi16(a, b);
+            auto const odd  = _mm512_mullo_epi16(_mm512_srli_epi16(a, 8), _mm512_srli_epi16(b, 8));
+            return bit_or(_mm512_slli_epi16(odd, 8), bit_and(even, _mm512_set1_epi16(0xff)));
+        }
+        else if constexpr (bits == 16)
+            return _mm512_mullo_epi16(a, b);
+        else if constexpr (bits == 32)
+            return _mm512_mullo_epi32(a, b);
+        else
+        {
+#if defined(__AVX512DQ__)
+            return _mm512_mullo_epi64(a, b);
+#else
+            return _mm512_mullox_epi64(a, b);
+#endif
+        }
+    };
+    auto const static inline div = [](auto const a, auto const b) {
+        return detail::lanewise<T>(a, b, [](auto const x, auto const y) { return x / y; });
+    };
+    auto const static inline store = [](auto p, auto const a) {
+        _mm512_store_si512(reinterpret_cast<__m512i*>(p), a);
+    };
+    auto const static inline stream = [](auto p, auto const a) {
+        _mm512_stream_si512(reinterpret_cast<__m512i*>(p), a);
+    };
+    auto const static inline unaligned_load
+        = [](auto p) { return _mm512_loadu_si512(reinterpret_cast<__m512i const*>(p)); };
+    auto const static inline unaligned_store = [](auto p, auto const a) {
+        _mm512_storeu_si512(reinterpret_cast<__m512i*>(p), a);
+    };
 
-//////////////////// std::int32_t ////////////////////
-template<>
-struct Type_<std::int32_t, 4>
+    auto const static inline fma  = [](auto const a, auto const b, auto const c) {
+        return add(mul(a, b), c);
+    };
+    auto const static inline fms  = [](auto const a, auto const b, auto const c) {
+        return sub(mul(a, b), c);
+    };
+    auto const static inline fnma = [](auto const a, auto const b, auto const c) {
+        return sub(c, mul(a, b));
+    };
+
+    auto const static inline min = [](auto const a, auto const b) {
+        if constexpr (bits == 8)
+            return std::is_signed_v<T> ? _mm512_min_epi8(a, b) : _mm512_min_epu8(a, b);
+        else if constexpr (bits == 16)
+            return std::is_signed_v<T> ? _mm512_min_epi16(a, b) : _mm512_min_epu16(a, b);
+        else if constexpr (bits == 32)
+            return std::is_signed_v<T> ? _mm512_min_epi32(a, b) : _mm512_min_epu32(a, b);
+        else
+            return std::is_signed_v<T> ? _mm512_min_epi64(a, b) : _mm512_min_epu64(a, b);
+    };
+    auto const static inline max = [](auto const a, auto const b) {
+        if constexpr (bits == 8)
+            return std::is_signed_v<T> ? _mm512_max_epi8(a, b) : _mm512_max_epu8(a, b);
+        else if constexpr (bits == 16)
+            return std::is_signed_v<T> ? _mm512_max_epi16(a, b) : _mm512_max_epu16(a, b);
+        else if constexpr (bits == 32)
+            return std::is_signed_v<T> ? _mm512_max_epi32(a, b) : _mm512_max_epu32(a, b);
+        else
+            return std::is_signed_v<T> ? _mm512_max_epi64(a, b) : _mm512_max_epu64(a, b);
+    };
+
+    auto const static inline shl = [](auto const a, int const n) {
+        auto const c = _mm_cvtsi32_si128(n);
+        if constexpr (bits == 8)
+            return bit_and(_mm512_sll_epi16(a, c), set_v(0xff << n)); // bytes from words
+        else if constexpr (bits == 16)
+            return _mm512_sll_epi16(a, c);
+        else if constexpr (bits == 32)
+            return _mm512_sll_epi32(a, c);
+        else
+            return _mm512_sll_epi64(a, c);
+    };
+    // arithmetic for signed lanes, logical for unsigned
+    auto const static inline shr = [](auto const a, int const n) {
+        auto const c = _mm_cvtsi32_si128(n);
+        if constexpr (std::is_signed_v<T> and bits == 16)
+            return _mm512_sra_epi16(a, c);
+        else if constexpr (std::is_signed_v<T> and bits == 32)
+            return _mm512_sra_epi32(a, c);
+        else if constexpr (std::is_signed_v<T> and bits == 64)
+            return _mm512_sra_epi64(a, c);
+        else if constexpr (std::is_signed_v<T>)
+        { // sign extend the logical shift, (x >> n ^ m) - m with m the shifted sign bit
+            using UInt   = Int_<U, 512>;
+            auto const m = UInt::set_v(static_cast<U>(U{1} << (bits - 1)) >> n);
+            return sub(bit_xor(UInt::shr(a, n), m), m);
+        }
+        else if constexpr (bits == 8)
+            return bit_and(_mm512_srl_epi16(a, c), set_v(0xff >> n));
+        else if constexpr (bits == 16)
+            return _mm512_srl_epi16(a, c);
+        else if constexpr (bits == 32)
+            return _mm512_srl_epi32(a, c);
+        else
+            return _mm512_srl_epi64(a, c);
+    };
+
+    auto const static inline add_sat = [](auto const a, auto const b) {
+        if constexpr (bits == 8)
+            return std::is_signed_v<T> ? _mm512_adds_epi8(a, b) : _mm512_adds_epu8(a, b);
+        else if constexpr (bits == 16)
+            return std::is_signed_v<T> ? _mm512_adds_epi16(a, b) : _mm512_adds_epu16(a, b);
+    };
+    auto const static inline sub_sat = [](auto const a, auto const b) {
+        if constexpr (bits == 8)
+            return std::is_signed_v<T> ? _mm512_subs_epi8(a, b) : _mm512_subs_epu8(a, b);
+        else if constexpr (bits == 16)
+            return std::is_signed_v<T> ? _mm512_subs_epi16(a, b) : _mm512_subs_epu16(a, b);
+    };
+
+    // lane masks are k registers, one bit per lane so movemask is the mask itself
+    //   8/16 bit lanes are avx512bw
+    auto const static inline cmp = [](auto const a, auto const b, auto p) {
+        auto constexpr P = decltype(p)::value;
+        if constexpr (bits == 8)
+            return std::is_signed_v<T> ? _mm512_cmp_epi8_mask(a, b, P)
+                                       : _mm512_cmp_epu8_mask(a, b, P);
+        else if constexpr (bits == 16)
+            return std::is_signed_v<T> ? _mm512_cmp_epi16_mask(a, b, P)
+                                       : _mm512_cmp_epu16_mask(a, b, P);
+        else if constexpr (bits == 32)
+            return std::is_signed_v<T> ? _mm512_cmp_epi32_mask(a, b, P)
+                                       : _mm512_cmp_epu32_mask(a, b, P);
+        else
+            return std::is_signed_v<T> ? _mm512_cmp_epi64_mask(a, b, P)
+                                       : _mm512_cmp_epu64_mask(a, b, P);
+    };
+    template<int P>
+    using Cmp = std::integral_constant<int, P>;
+
+    auto const static inline lt
+        = [](auto const a, auto const b) { return cmp(a, b, Cmp<_MM_CMPINT_LT>{}); };
+    auto const static inline le
+        = [](auto const a, auto const b) { return cmp(a, b, Cmp<_MM_CMPINT_LE>{}); };
+    auto const static inline gt
+        = [](auto const a, auto const b) { return cmp(a, b, Cmp<_MM_CMPINT_NLE>{}); };
+    auto const static inline ge
+        = [](auto const a, auto const b) { return cmp(a, b, Cmp<_MM_CMPINT_NLT>{}); };
+    auto const static inline eq
+        = [](auto const a, auto const b) { return cmp(a, b, Cmp<_MM_CMPINT_EQ>{}); };
+    auto const static inline neq
+        = [](auto const a, auto const b) { return cmp(a, b, Cmp<_MM_CMPINT_NE>{}); };
+    auto const static inline movemask = [](auto const m) { return m; };
+
+    // avx512 only, see Type_<double, 8>
+    //   8/16 bit compress/expand are avx512vbmi2 and 8 bit permute avx512vbmi, without
+    //   those they go lane by lane
+    using mask_t = std::conditional_t<
+        bits == 8, __mmask64,
+        std::conditional_t<bits == 16, __mmask32,
+                           std::conditional_t<bits == 32, __mmask16, __mmask8>>>;
+    auto const static inline mask = [](auto const n) { // n <= SIZE
+        return static_cast<mask_t>(n < 64 ? (std::uint64_t{1} << n) - 1 : ~std::uint64_t{0});
+    };
+    auto const static inline select = [](auto const m, auto const a, auto const b) {
+        if constexpr (bits == 8)
+            return _mm512_mask_blend_epi8(m, b, a);
+        else if constexpr (bits == 16)
+            return _mm512_mask_blend_epi16(m, b, a);
+        else if constexpr (bits == 32)
+            return _mm512_mask_blend_epi32(m, b, a);
+        else
+            return _mm512_mask_blend_epi64(m, b, a);
+    };
+
+    auto const static inline compress = [](auto const m, auto const a) {
+        if constexpr (bits == 32)
+            return _mm512_maskz_compress_epi32(m, a);
+        else if constexpr (bits == 64)
+            return _mm512_maskz_compress_epi64(m, a);
+#if defined(__AVX512VBMI2__)
+        else if constexpr (bits == 16)
+            return _mm512_maskz_compress_epi16(m, a);
+        else
+            return _mm512_maskz_compress_epi8(m, a);
+#else
+        else
+            return detail::compress_lanes<T>(m, a);
+#endif
+    };
+    auto const static inline expand = [](auto const m, auto const a) {
+        if constexpr (bits == 32)
+            return _mm512_maskz_expand_epi32(m, a);
+        else if constexpr (bits == 64)
+            return _mm512_maskz_expand_epi64(m, a);
+#if defined(__AVX512VBMI2__)
+        else if constexpr (bits == 16)
+            return _mm512_maskz_expand_epi16(m, a);
+        else
+            return _mm512_maskz_expand_epi8(m, a);
+#else
+        else
+            return detail::expand_lanes<T>(m, a);
+#endif
+    };
+    auto const static inline compress_store = [](auto p, auto const m, auto const a) {
+        if constexpr (bits == 32)
+            _mm512_mask_compressstoreu_epi32(p, m, a);
+        else if constexpr (bits == 64)
+            _mm512_mask_compressstoreu_epi64(p, m, a);
+        else if constexpr (bits == 16)
+            _mm512_mask_storeu_epi16(p, mask(std::popcount(m)), compress(m, a));
+        else
+            _mm512_mask_storeu_epi8(p, mask(std::popcount(m)), compress(m, a));
+    };
+    auto const static inline permute = [](auto const idx, auto const a) {
+        if constexpr (bits == 8)
+        {
+#if defined(__AVX512VBMI__)
+            return _mm512_permutexvar_epi8(idx, a);
+#else
+            return detail::permute_lanes<T>(idx, a);
+#endif
+        }
+        else if constexpr (bits == 16)
+            return _mm512_permutexvar_epi16(idx, a);
+        else if constexpr (bits == 32)
+            return _mm512_permutexvar_epi32(idx, a);
+        else
+            return _mm512_permutexvar_epi64(idx, a);
+    };
+    auto const static inline ternarylogic = [](auto const a, auto const b, auto const c, auto i) {
+        return _mm512_ternarylogic_epi64(a, b, c, decltype(i)::value);
+    };
+
+    // the blend folds into the op's mask register
+    auto const static inline mask_add = [](auto const src, auto const m, auto const a,
+                                           auto const b) { return select(m, add(a, b), src); };
+    auto const static inline mask_sub = [](auto const src, auto const m, auto const a,
+                                           auto const b) { return select(m, sub(a, b), src); };
+    auto const static inline mask_mul = [](auto const src, auto const m, auto const a,
+                                           auto const b) { return select(m, mul(a, b), src); };
+    auto const static inline mask_div = [](auto const src, auto const m, auto const a,
+                                           auto const b) { return select(m, div(a, b), src); };
+
+    // see Type_<double, 8>, 8/16 bit lanes have no gather/scatter and go lane by lane
+    auto const static inline gather = [](auto p, auto const idx) {
+        if constexpr (bits == 32)
+            return _mm512_i32gather_epi32(idx, p, 4);
+        else if constexpr (bits == 64)
+            return _mm512_i64gather_epi64(idx, p, 8);
+        else
+            return detail::gather_lanes<T, __m512i>(p, idx);
+    };
+    auto const static inline scatter = [](auto p, auto const idx, auto const a) {
+        if constexpr (bits == 32)
+            _mm512_i32scatter_epi32(p, idx, a, 4);
+        else if constexpr (bits == 64)
+            _mm512_i64scatter_epi64(p, idx, a, 8);
+        else
+            detail::scatter_lanes<T>(p, idx, a);
+    };
+    auto const static inline scatter_add = [](auto p, auto const idx, auto const a) {
+#if defined(__AVX512CD__)
+        if constexpr (bits == 32)
+        {
+            auto const conflicts = _mm512_conflict_epi32(idx);
+            for (auto todo = mask(16); todo;)
+            {
+                auto const pending = _mm512_set1_epi32(todo);
+                auto const ready   = _mm512_mask_testn_epi32_mask(todo, conflicts, pending);
+                auto const v       = _mm512_mask_i32gather_epi32(a, ready, idx, p, 4);
+                _mm512_mask_i32scatter_epi32(p, ready, idx, add(v, a), 4);
+                todo = static_cast<mask_t>(todo & ~ready);
+            }
+        }
+        else if constexpr (bits == 64)
+        {
+            auto const conflicts = _mm512_conflict_epi64(idx);
+            for (auto todo = mask(8); todo;)
+            {
+                auto const pending = _mm512_set1_epi64(todo);
+                auto const ready   = _mm512_mask_testn_epi64_mask(todo, conflicts, pending);
+                auto const v       = _mm512_mask_i64gather_epi64(a, ready, idx, p, 8);
+                _mm512_mask_i64scatter_epi64(p, ready, idx, add(v, a), 8);
+                todo = static_cast<mask_t>(todo & ~ready);
+            }
+        }
+        else
+#endif
+            detail::scatter_add_lanes<T>(p, idx, a);
+    };
+};
+
+template<typename T, std::size_t SIZE>
+    requires(detail::is_lane_int_v<T> and SIZE * sizeof(T) == 16)
+struct Type_<T, SIZE> : Int_<T, 128>
 {
-    using internal_type          = __m128i;
-    auto const static inline add = [](auto&&... v) { return _mm_add_epi32(v...); };
-    auto const static inline mul = [](auto&&... v) { return _mm_mullo_epi32(v...); };
-    // auto const static inline fma = _mm256_fmadd_ps;
 };
-template<>
-struct Type_<std::int32_t, 8>
+template<typename T, std::size_t SIZE>
+    requires(detail::is_lane_int_v<T> and SIZE * sizeof(T) == 32)
+struct Type_<T, SIZE> : Int_<T, 256>
+{
+};
+template<typename T, std::size_t SIZE>
+    requires(detail::is_lane_int_v<T> and SIZE * sizeof(T) == 64)
+struct Type_<T, SIZE> : Int_<T, 512>
 {
-    using internal_type          = __m256i;
-    auto const static inline add = [](auto&&... v) { return _mm256_add_epi32(v...); };
-    auto const static inline mul = [](auto&&... v) { return _mm256_mullo_epi32(v...); };
-    // auto const static inline fma = _mm256_fmadd_ps;
 };
-//////////////////// std::int32_t ////////////////////
+//////////////////// integers ////////////////////
 
 
 
-// //////////////////// std::uint32_t ////////////////////
-// template<>
-// struct  Type_<std::uint32_t, 8>
-// {
-//     using internal_type                = __m256;
-//     auto const static inline add = _mm256_add_epu32;
-//     auto const static inline mul = _mm256_mul_epu32;
-//     // auto const static inline fma = _mm256_fmadd_ps;
-// };
-// //////////////////// std::int32_t ////////////////////
-// //////////////////// std::uint64_t ////////////////////
-// template<>
-// struct  Type_<std::int64_t, 4>
-// {
-//     using internal_type                = __m256;
-//     auto const static inline add = _mm256_add_epi64;
-//     auto const static inline mul = _mm256_mul_epi64;
-//     // auto const static inline fma = _mm256_fmadd_ps;
-// };
-//////////////////// std::uint64_t ////////////////////
+// masked_load/masked_store over the first n < SIZE lanes, for ragged tails
+//   masked_load zeroes the other lanes, masked_fill(a, n, v) sets those of a to v
+template<typename T, std::size_t SIZE, typename = void>
+struct has_masked : std::false_type
+{
+};
+template<typename T, std::size_t SIZE>
+struct has_masked<T, SIZE, std::void_t<decltype(Type_<T, SIZE>::masked_load)>> : std::true_type
+{
+};
+template<typename T, std::size_t SIZE>
+inline constexpr bool has_masked_v = has_masked<T, SIZE>::value;
 
+// stream, a non-temporal store, where the width has one
+template<typename T, std::size_t SIZE, typename = void>
+struct has_stream : std::false_type
+{
+};
+template<typename T, std::size_t SIZE>
+struct has_stream<T, SIZE, std::void_t<decltype(Type_<T, SIZE>::stream)>> : std::true_type
+{
+};
+template<typename T, std::size_t SIZE>
+inline constexpr bool has_stream_v = has_stream<T, SIZE>::value;
 
 
 template<typename T, std::size_t SIZE>
@@ -271,6 +1751,8 @@ struct Type : public SuperType<T, SIZE>
     auto const static inline div   = Type_<T, SIZE>::div;
     auto const static inline store = Type_<T, SIZE>::store;
     auto const static inline set_v = Type_<T, SIZE>::set_v;
+    auto const static inline min   = Type_<T, SIZE>::min;
+    auto const static inline max   = Type_<T, SIZE>::max;
     // auto constexpr static fma = Type_<T, SIZE>::fma;
 
     Type() noexcept = default;
@@ -347,6 +1829,14 @@ void inline store(T* __restrict a, Type<T, SIZE> const& __restrict b) noexcept
     Type<T, SIZE>::Super::impl_type::store(a, b());
 }
 
+// non-temporal, bypasses the cache on the way to aligned a - order a run of them
+// against later stores with _mm_sfence()
+template<typename T, std::size_t SIZE>
+void inline stream(T* __restrict a, Type<T, SIZE> const& __restrict b) noexcept
+{
+    Type<T, SIZE>::Super::impl_type::stream(a, b());
+}
+
 template<typename T, std::size_t SIZE>
 Type<T, SIZE> unaligned_load(T const* __restrict a) noexcept
 {
@@ -366,6 +1856,428 @@ Type<T, SIZE> inline fma(Type<T, SIZE> const& a, Type<T, SIZE> const& b,
     return {Type<T, SIZE>::Super::impl_type::fma(a(), b(), c())};
 }
 
+// a * b - c
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline fms(Type<T, SIZE> const& a, Type<T, SIZE> const& b,
+                         Type<T, SIZE> const& c) noexcept
+{
+    return {Type<T, SIZE>::Super::impl_type::fms(a(), b(), c())};
+}
+
+// c - a * b
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline fnma(Type<T, SIZE> const& a, Type<T, SIZE> const& b,
+                          Type<T, SIZE> const& c) noexcept
+{
+    return {Type<T, SIZE>::Super::impl_type::fnma(a(), b(), c())};
+}
+
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline min(Type<T, SIZE> const& a, Type<T, SIZE> const& b) noexcept
+{
+    return {Type<T, SIZE>::min(a(), b())};
+}
+
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline max(Type<T, SIZE> const& a, Type<T, SIZE> const& b) noexcept
+{
+    return {Type<T, SIZE>::max(a(), b())};
+}
+
+
+// integer lanes, see Int_
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline operator&(Type<T, SIZE> const& a, Type<T, SIZE> const& b) noexcept
+{
+    return {Type<T, SIZE>::Super::impl_type::bit_and(a(), b())};
+}
+
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline operator|(Type<T, SIZE> const& a, Type<T, SIZE> const& b) noexcept
+{
+    return {Type<T, SIZE>::Super::impl_type::bit_or(a(), b())};
+}
+
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline operator^(Type<T, SIZE> const& a, Type<T, SIZE> const& b) noexcept
+{
+    return {Type<T, SIZE>::Super::impl_type::bit_xor(a(), b())};
+}
+
+// ~a & b
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline andnot(Type<T, SIZE> const& a, Type<T, SIZE> const& b) noexcept
+{
+    return {Type<T, SIZE>::Super::impl_type::bit_andnot(a(), b())};
+}
+
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline operator<<(Type<T, SIZE> const& a, int const n) noexcept
+{
+    return {Type<T, SIZE>::Super::impl_type::shl(a(), n)};
+}
+
+// arithmetic for signed lanes
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline operator>>(Type<T, SIZE> const& a, int const n) noexcept
+{
+    return {Type<T, SIZE>::Super::impl_type::shr(a(), n)};
+}
+
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline add_sat(Type<T, SIZE> const& a, Type<T, SIZE> const& b) noexcept
+{
+    return {Type<T, SIZE>::Super::impl_type::add_sat(a(), b())};
+}
+
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline sub_sat(Type<T, SIZE> const& a, Type<T, SIZE> const& b) noexcept
+{
+    return {Type<T, SIZE>::Super::impl_type::sub_sat(a(), b())};
+}
+
+
+// lanewise comparison result, all ones/zero lanes in a register before avx512, a k
+// register with it and a bool for a single lane
+//   & | ^ ~ combine masks of the same Type, any/all/none/count read them
+template<typename T, std::size_t SIZE>
+struct Mask
+{
+    using impl_type = Type_<T, SIZE>;
+    using array_t   = std::decay_t<decltype(impl_type::eq(
+        std::declval<typename impl_type::internal_type&>(),
+        std::declval<typename impl_type::internal_type&>()))>;
+
+    inline array_t& operator()() noexcept { return array; }
+    inline array_t const& operator()() const noexcept { return array; }
+
+    array_t array;
+};
+
+template<typename T, std::size_t SIZE>
+Mask<T, SIZE> inline operator<(Type<T, SIZE> const& a, Type<T, SIZE> const& b) noexcept
+{
+    return {Type<T, SIZE>::Super::impl_type::lt(a(), b())};
+}
+
+template<typename T, std::size_t SIZE>
+Mask<T, SIZE> inline operator<=(Type<T, SIZE> const& a, Type<T, SIZE> const& b) noexcept
+{
+    return {Type<T, SIZE>::Super::impl_type::le(a(), b())};
+}
+
+template<typename T, std::size_t SIZE>
+Mask<T, SIZE> inline operator>(Type<T, SIZE> const& a, Type<T, SIZE> const& b) noexcept
+{
+    return {Type<T, SIZE>::Super::impl_type::gt(a(), b())};
+}
+
+template<typename T, std::size_t SIZE>
+Mask<T, SIZE> inline operator>=(Type<T, SIZE> const& a, Type<T, SIZE> const& b) noexcept
+{
+    return {Type<T, SIZE>::Super::impl_type::ge(a(), b())};
+}
+
+template<typename T, std::size_t SIZE>
+Mask<T, SIZE> inline operator==(Type<T, SIZE> const& a, Type<T, SIZE> const& b) noexcept
+{
+    return {Type<T, SIZE>::Super::impl_type::eq(a(), b())};
+}
+
+// true for NaN lanes
+template<typename T, std::size_t SIZE>
+Mask<T, SIZE> inline operator!=(Type<T, SIZE> const& a, Type<T, SIZE> const& b) noexcept
+{
+    return {Type<T, SIZE>::Super::impl_type::neq(a(), b())};
+}
+
+// m ? a : b per lane
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline select(Mask<T, SIZE> const& m, Type<T, SIZE> const& a,
+                            Type<T, SIZE> const& b) noexcept
+{
+    return {Type_<T, SIZE>::select(m(), a(), b())};
+}
+
+template<typename T, std::size_t SIZE>
+Mask<T, SIZE> inline operator&(Mask<T, SIZE> const& a, Mask<T, SIZE> const& b) noexcept
+{
+    using M = Mask<T, SIZE>::array_t;
+    if constexpr (std::is_integral_v<M>)
+        return {static_cast<M>(a() & b())};
+    else
+        return {Type_<T, SIZE>::select(a(), b(), a())};
+}
+
+template<typename T, std::size_t SIZE>
+Mask<T, SIZE> inline operator|(Mask<T, SIZE> const& a, Mask<T, SIZE> const& b) noexcept
+{
+    using M = Mask<T, SIZE>::array_t;
+    if constexpr (std::is_integral_v<M>)
+        return {static_cast<M>(a() | b())};
+    else
+        return {Type_<T, SIZE>::select(a(), a(), b())};
+}
+
+template<typename T, std::size_t SIZE>
+Mask<T, SIZE> inline operator^(Mask<T, SIZE> const& a, Mask<T, SIZE> const& b) noexcept
+{
+    using M = Mask<T, SIZE>::array_t;
+    if constexpr (std::is_integral_v<M>)
+        return {static_cast<M>(a() ^ b())};
+    else
+        return {Type_<T, SIZE>::bit_xor(a(), b())};
+}
+
+template<typename T, std::size_t SIZE>
+Mask<T, SIZE> inline operator~(Mask<T, SIZE> const& a) noexcept
+{
+    using M = Mask<T, SIZE>::array_t;
+    if constexpr (std::is_same_v<M, bool>)
+        return {!a()};
+    else if constexpr (std::is_integral_v<M>) // only the low SIZE bits are lanes
+        return {static_cast<M>(~a())};
+    else
+    {
+        using Impl   = Type_<T, SIZE>;
+        auto const z = Impl::set_v(0);
+        return {Impl::bit_xor(a(), Impl::eq(z, z))};
+    }
+}
+
+// one bit per lane, lane 0 the lowest
+template<typename T, std::size_t SIZE>
+auto inline movemask(Mask<T, SIZE> const& m) noexcept
+{
+    auto constexpr all = SIZE < 64 ? (std::uint64_t{1} << SIZE) - 1 : ~std::uint64_t{0};
+    return static_cast<std::uint64_t>(Type_<T, SIZE>::movemask(m())) & all;
+}
+
+template<typename T, std::size_t SIZE>
+bool inline any(Mask<T, SIZE> const& m) noexcept
+{
+    return movemask(m) != 0;
+}
+
+template<typename T, std::size_t SIZE>
+bool inline none(Mask<T, SIZE> const& m) noexcept
+{
+    return movemask(m) == 0;
+}
+
+template<typename T, std::size_t SIZE>
+std::size_t inline count(Mask<T, SIZE> const& m) noexcept
+{
+    return std::popcount(movemask(m));
+}
+
+template<typename T, std::size_t SIZE>
+bool inline all(Mask<T, SIZE> const& m) noexcept
+{
+    return count(m) == SIZE;
+}
+
+// where(m, v) op= x only updates the lanes of v set in m, e.g. where(a > b, a) = b
+//   every lane of the op is still computed, so integer division wants no zero in x
+template<typename T, std::size_t SIZE>
+struct Where
+{
+    using V = Type<T, SIZE>;
+
+    void operator=(V const& x) noexcept { v = select(m, x, v); }
+    void operator=(T const x) noexcept { *this = V{V::set_v(x)}; }
+    void operator+=(V const& x) noexcept { v = select(m, v + x, v); }
+    void operator-=(V const& x) noexcept { v = select(m, v - x, v); }
+    void operator*=(V const& x) noexcept { v = select(m, v * x, v); }
+    void operator/=(V const& x) noexcept { v = select(m, v / x, v); }
+
+    Mask<T, SIZE> const m;
+    V& v;
+};
+
+template<typename T, std::size_t SIZE>
+Where<T, SIZE> inline where(Mask<T, SIZE> const& m, Type<T, SIZE>& v) noexcept
+{
+    return {m, v};
+}
+
+
+// indexed access, idx lanes are signed and as wide as T, 8/16 bit lanes reach 127/32767
+//   hardware gathers need avx2 (32/64 bit lanes) and scatters avx512, the rest go
+//   lane by lane - scatter_add accumulates repeated indices in lane order
+
+// lane i is p[idx[i]]
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline gather(T const* p, Type<detail::index_t<T>, SIZE> const& idx) noexcept
+{
+    return {Type_<T, SIZE>::gather(p, idx())};
+}
+
+// p[idx[i]] = a[i], the last of repeated indices wins
+template<typename T, std::size_t SIZE>
+void inline scatter(T* p, Type<detail::index_t<T>, SIZE> const& idx,
+                    Type<T, SIZE> const& a) noexcept
+{
+    Type_<T, SIZE>::scatter(p, idx(), a());
+}
+
+// p[idx[i]] += a[i]
+template<typename T, std::size_t SIZE>
+void inline scatter_add(T* p, Type<detail::index_t<T>, SIZE> const& idx,
+                        Type<T, SIZE> const& a) noexcept
+{
+    Type_<T, SIZE>::scatter_add(p, idx(), a());
+}
+
+
+// avx512 only, see Type_<double, 8>
+template<typename T, std::size_t SIZE>
+using mask_t = typename Type_<T, SIZE>::mask_t;
+
+// lanes of a set in m packed to the front, the rest zero
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline compress(Type<T, SIZE> const& a, mask_t<T, SIZE> const m) noexcept
+{
+    return {Type<T, SIZE>::Super::impl_type::compress(m, a())};
+}
+
+// the front lanes of a spread to the lanes set in m, the rest zero
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline expand(Type<T, SIZE> const& a, mask_t<T, SIZE> const m) noexcept
+{
+    return {Type<T, SIZE>::Super::impl_type::expand(m, a())};
+}
+
+// lanes of a set in m written contiguously from p, returns how many
+template<typename T, std::size_t SIZE>
+std::size_t inline compress_store(T* p, Type<T, SIZE> const& a, mask_t<T, SIZE> const m) noexcept
+{
+    Type<T, SIZE>::Super::impl_type::compress_store(p, m, a());
+    return std::popcount(m);
+}
+
+// lane i is a[idx[i]]
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline permute(Type<detail::index_t<T>, SIZE> const& idx,
+                             Type<T, SIZE> const& a) noexcept
+{
+    return {Type<T, SIZE>::Super::impl_type::permute(idx(), a())};
+}
+
+// any bitwise function of three inputs, IMM is its truth table indexed by
+// (a << 2) | (b << 1) | c, e.g. 0xCA is a ? b : c and 0x96 is a ^ b ^ c
+template<int IMM, typename T, std::size_t SIZE>
+Type<T, SIZE> inline ternarylogic(Type<T, SIZE> const& a, Type<T, SIZE> const& b,
+                                  Type<T, SIZE> const& c) noexcept
+{
+    using Imm = std::integral_constant<int, IMM>;
+    return {Type<T, SIZE>::Super::impl_type::ternarylogic(a(), b(), c(), Imm{})};
+}
+
+// m ? a op b : src per lane
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline mask_add(Type<T, SIZE> const& src, mask_t<T, SIZE> const m,
+                              Type<T, SIZE> const& a, Type<T, SIZE> const& b) noexcept
+{
+    return {Type<T, SIZE>::Super::impl_type::mask_add(src(), m, a(), b())};
+}
+
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline mask_sub(Type<T, SIZE> const& src, mask_t<T, SIZE> const m,
+                              Type<T, SIZE> const& a, Type<T, SIZE> const& b) noexcept
+{
+    return {Type<T, SIZE>::Super::impl_type::mask_sub(src(), m, a(), b())};
+}
+
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline mask_mul(Type<T, SIZE> const& src, mask_t<T, SIZE> const m,
+                              Type<T, SIZE> const& a, Type<T, SIZE> const& b) noexcept
+{
+    return {Type<T, SIZE>::Super::impl_type::mask_mul(src(), m, a(), b())};
+}
+
+template<typename T, std::size_t SIZE>
+Type<T, SIZE> inline mask_div(Type<T, SIZE> const& src, mask_t<T, SIZE> const m,
+                              Type<T, SIZE> const& a, Type<T, SIZE> const& b) noexcept
+{
+    return {Type<T, SIZE>::Super::impl_type::mask_div(src(), m, a(), b())};
+}
+
+// floating point under an explicit rounding mode rather than MXCSR's
+template<Rounding R, typename T, std::size_t SIZE>
+Type<T, SIZE> inline add_round(Type<T, SIZE> const& a, Type<T, SIZE> const& b) noexcept
+{
+    using Mode = std::integral_constant<Rounding, R>;
+    return {Type<T, SIZE>::Super::impl_type::add_round(a(), b(), Mode{})};
+}
+
+template<Rounding R, typename T, std::size_t SIZE>
+Type<T, SIZE> inline sub_round(Type<T, SIZE> const& a, Type<T, SIZE> const& b) noexcept
+{
+    using Mode = std::integral_constant<Rounding, R>;
+    return {Type<T, SIZE>::Super::impl_type::sub_round(a(), b(), Mode{})};
+}
+
+template<Rounding R, typename T, std::size_t SIZE>
+Type<T, SIZE> inline mul_round(Type<T, SIZE> const& a, Type<T, SIZE> const& b) noexcept
+{
+    using Mode = std::integral_constant<Rounding, R>;
+    return {Type<T, SIZE>::Super::impl_type::mul_round(a(), b(), Mode{})};
+}
+
+template<Rounding R, typename T, std::size_t SIZE>
+Type<T, SIZE> inline div_round(Type<T, SIZE> const& a, Type<T, SIZE> const& b) noexcept
+{
+    using Mode = std::integral_constant<Rounding, R>;
+    return {Type<T, SIZE>::Super::impl_type::div_round(a(), b(), Mode{})};
+}
+
+template<Rounding R, typename T, std::size_t SIZE>
+Type<T, SIZE> inline fma_round(Type<T, SIZE> const& a, Type<T, SIZE> const& b,
+                               Type<T, SIZE> const& c) noexcept
+{
+    using Mode = std::integral_constant<Rounding, R>;
+    return {Type<T, SIZE>::Super::impl_type::fma_round(a(), b(), c(), Mode{})};
+}
+
+template<Rounding R, typename T, std::size_t SIZE>
+Type<T, SIZE> inline sqrt_round(Type<T, SIZE> const& a) noexcept
+{
+    using Mode = std::integral_constant<Rounding, R>;
+    return {Type<T, SIZE>::Super::impl_type::sqrt_round(a(), Mode{})};
+}
+
+
+// horizontal - fn over lanes in order, once per reduction so not worth
+// per width shuffles
+template<typename T, std::size_t SIZE, typename Fn>
+T inline reduce(Type<T, SIZE> const& a, Fn const& fn) noexcept
+{
+    auto const* lanes = reinterpret_cast<typename Type<T, SIZE>::lane_t const*>(&a());
+    T ret             = lanes[0];
+    for (std::size_t i = 1; i < SIZE; ++i)
+        ret = fn(ret, lanes[i]);
+    return ret;
+}
+
+template<typename T, std::size_t SIZE>
+T inline hsum(Type<T, SIZE> const& a) noexcept
+{
+    return reduce(a, [](auto const& x, auto const& y) { return x + y; });
+}
+
+template<typename T, std::size_t SIZE>
+T inline hmin(Type<T, SIZE> const& a) noexcept
+{
+    return reduce(a, [](auto const& x, auto const& y) { return x < y ? x : y; });
+}
+
+template<typename T, std::size_t SIZE>
+T inline hmax(Type<T, SIZE> const& a) noexcept
+{
+    return reduce(a, [](auto const& x, auto const& y) { return x > y ? x : y; });
+}
+
 } /* namespace mkn::avx */
 
 
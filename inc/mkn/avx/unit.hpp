@@ -43,7 +43,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <cstring>
 
 
-namespace mkn::avx
+namespace mkn::avx::inline MKN_AVX_TIER
 {
 
 template<typename T, std::size_t _N = Options::N<std::decay_t<T>>()>
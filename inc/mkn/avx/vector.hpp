@@ -37,7 +37,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <vector>
 
-namespace mkn::avx
+namespace mkn::avx::inline MKN_AVX_TIER
 {
 
 template<typename T, typename Allocator = kul::AlignedAllocator<T, Options::ALIGN()>>
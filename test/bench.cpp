@@ -48,6 +48,22 @@ void inline NO_VECTORIZE mul_inplace(Float* a, Float const* b) noexcept
         a[i] *= b[i];
 }
 
+template<std::uint64_t SIZE, typename Float, typename Index>
+void inline NO_VECTORIZE gather(Float const* a, Index const* idx, Float* c) noexcept
+{
+#pragma clang loop vectorize(disable)
+    for (std::size_t i = 0; i < SIZE; ++i)
+        c[i] = a[idx[i]];
+}
+
+template<std::uint64_t SIZE, typename Float, typename Index>
+void inline NO_VECTORIZE scatter_add(Float const* a, Index const* idx, Float* c) noexcept
+{
+#pragma clang loop vectorize(disable)
+    for (std::size_t i = 0; i < SIZE; ++i)
+        c[idx[i]] += a[i];
+}
+
 template<std::uint64_t SIZE, typename Float>
 void inline NO_VECTORIZE multiply_and_add(Float const* a, Float const* b, Float const* c,
                                           Float* d) noexcept
@@ -94,6 +110,18 @@ void mul_avx(benchmark::State& state)
 }
 
 
+// c is written with non-temporal stores, bypassing the cache
+template<typename T>
+void mul_avx_stream(benchmark::State& state)
+{
+    mkn::avx::Vector<T> v0(SIZE, 2), v1(SIZE, 2), v2(SIZE);
+    auto [a, b, c] = mkn::avx::make_spans(v0, v1, v2);
+
+    for (auto _ : state)
+        c.template mul<mkn::avx::Store::STREAM>(a, b);
+}
+
+
 template<typename T>
 void mul_avx_inplace(benchmark::State& state)
 {
@@ -149,6 +177,62 @@ void add_avx_inplace_single(benchmark::State& state)
 }
 
 
+// indices spread over state.range(0) elements, from cache resident to memory bound
+template<typename T>
+auto indices(std::size_t const window)
+{
+    mkn::avx::Vector<mkn::avx::detail::index_t<T>> idx(SIZE);
+    std::uint64_t x = 88172645463325252ull;
+    for (auto& i : idx)
+        x ^= x << 13, x ^= x >> 7, x ^= x << 17, i = x % window;
+    return idx;
+}
+
+template<typename T>
+void gather_no_avx(benchmark::State& state)
+{
+    auto const idx = indices<T>(state.range(0));
+    std::vector<T> a(SIZE, 2), c(SIZE);
+
+    for (auto _ : state)
+        mkn::noavx::gather<SIZE>(&a[0], &idx[0], &c[0]);
+}
+
+template<typename T>
+void gather_avx(benchmark::State& state)
+{
+    auto idx = indices<T>(state.range(0));
+    mkn::avx::Vector<T> v0(SIZE, 2), v1(SIZE);
+    auto [a, c] = mkn::avx::make_spans(v0, v1);
+    auto [i]    = mkn::avx::make_spans(idx);
+
+    for (auto _ : state)
+        c.gather(a, i);
+}
+
+template<typename T>
+void scatter_add_no_avx(benchmark::State& state)
+{
+    auto const idx = indices<T>(state.range(0));
+    std::vector<T> a(SIZE, 2), c(SIZE);
+
+    for (auto _ : state)
+        mkn::noavx::scatter_add<SIZE>(&a[0], &idx[0], &c[0]);
+}
+
+template<typename T>
+void scatter_add_avx(benchmark::State& state)
+{
+    auto idx = indices<T>(state.range(0));
+    mkn::avx::Vector<T> v0(SIZE, 2), v1(SIZE);
+    auto [a, c] = mkn::avx::make_spans(v0, v1);
+    auto [i]    = mkn::avx::make_spans(idx);
+
+    for (auto _ : state)
+        a.scatter_add(c, i);
+}
+
+
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////////////
@@ -157,6 +241,7 @@ void add_avx_inplace_single(benchmark::State& state)
 BENCHMARK_TEMPLATE(mul_no_avx, double)->Unit(benchmark::kMicrosecond);
 BENCHMARK_TEMPLATE(mul_no_avx_inplace, double)->Unit(benchmark::kMicrosecond);
 BENCHMARK_TEMPLATE(mul_avx, double)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(mul_avx_stream, double)->Unit(benchmark::kMicrosecond);
 BENCHMARK_TEMPLATE(mul_avx_inplace, double)->Unit(benchmark::kMicrosecond);
 BENCHMARK_TEMPLATE(mul_avx_inplace_array, double)->Unit(benchmark::kMicrosecond);
 BENCHMARK_TEMPLATE(mul_avx_inplace_single, double)->Unit(benchmark::kMicrosecond);
@@ -172,6 +257,7 @@ BENCHMARK_TEMPLATE(add_avx_inplace_single, double)->Unit(benchmark::kMicrosecond
 BENCHMARK_TEMPLATE(mul_no_avx, float)->Unit(benchmark::kMicrosecond);
 BENCHMARK_TEMPLATE(mul_no_avx_inplace, float)->Unit(benchmark::kMicrosecond);
 BENCHMARK_TEMPLATE(mul_avx, float)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(mul_avx_stream, float)->Unit(benchmark::kMicrosecond);
 BENCHMARK_TEMPLATE(mul_avx_inplace, float)->Unit(benchmark::kMicrosecond);
 BENCHMARK_TEMPLATE(mul_avx_inplace_array, float)->Unit(benchmark::kMicrosecond);
 BENCHMARK_TEMPLATE(mul_avx_inplace_single, float)->Unit(benchmark::kMicrosecond);
@@ -185,11 +271,33 @@ BENCHMARK_TEMPLATE(add_avx_inplace_single, float)->Unit(benchmark::kMicrosecond)
 //////////////////////////////////////////////////////////////////////////////
 
 
-// BENCHMARK_TEMPLATE(mul_avx_inplace, std::uint32_t)->Unit(benchmark::kMicrosecond);
-// BENCHMARK_TEMPLATE(mul_avx_inplace_array, std::uint32_t)->Unit(benchmark::kMicrosecond);
-// BENCHMARK_TEMPLATE(mul_avx_inplace_single, std::uint32_t)->Unit(benchmark::kMicrosecond);
-// BENCHMARK_TEMPLATE(add_avx_inplace, std::uint32_t)->Unit(benchmark::kMicrosecond);
-// BENCHMARK_TEMPLATE(add_avx_inplace_single, std::uint32_t)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(mul_avx_inplace, std::uint32_t)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(mul_avx_inplace_array, std::uint32_t)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(mul_avx_inplace_single, std::uint32_t)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(add_avx_inplace, std::uint32_t)->Unit(benchmark::kMicrosecond);
+BENCHMARK_TEMPLATE(add_avx_inplace_single, std::uint32_t)->Unit(benchmark::kMicrosecond);
+
+
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+//////////////////////////////////////////////////////////////////////////////
+
+
+// index windows from cache resident to memory bound, compare the _avx and _no_avx
+// rows per window - scatter throughput varies a lot between cores
+void windows(benchmark::internal::Benchmark* b)
+{
+    b->RangeMultiplier(32)->Range(1 << 10, 1 << 19)->Unit(benchmark::kMicrosecond);
+}
+
+BENCHMARK_TEMPLATE(gather_no_avx, double)->Apply(windows);
+BENCHMARK_TEMPLATE(gather_avx, double)->Apply(windows);
+BENCHMARK_TEMPLATE(scatter_add_no_avx, double)->Apply(windows);
+BENCHMARK_TEMPLATE(scatter_add_avx, double)->Apply(windows);
+BENCHMARK_TEMPLATE(gather_no_avx, float)->Apply(windows);
+BENCHMARK_TEMPLATE(gather_avx, float)->Apply(windows);
+BENCHMARK_TEMPLATE(scatter_add_no_avx, float)->Apply(windows);
+BENCHMARK_TEMPLATE(scatter_add_avx, float)->Apply(windows);
 
 
 //////////////////////////////////////////////////////////////////////////////
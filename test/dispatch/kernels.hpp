@@ -0,0 +1,24 @@
+#ifndef _MKN_AVX_TEST_DISPATCH_KERNELS_HPP_
+#define _MKN_AVX_TEST_DISPATCH_KERNELS_HPP_
+
+#include "mkn/avx/dispatch.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+// kernels.ipp is built once per tier, by kernels_none.cpp without -m flags and
+// kernels_avx2.cpp with -mavx2 -mfma, then linked with main.cpp
+
+inline constinit mkn::avx::Dispatch<void(double*, double const*, std::size_t)> add_to{};
+
+// addresses of the same instantiations in each tier build
+struct Symbols
+{
+    mkn::avx::ISA isa;
+    std::uintptr_t add, min;
+};
+
+extern Symbols const symbols_isa_none;
+extern Symbols const symbols_isa_avx2;
+
+#endif /* _MKN_AVX_TEST_DISPATCH_KERNELS_HPP_ */
@@ -0,0 +1,25 @@
+
+#include "kernels.hpp"
+
+#include "mkn/avx.hpp"
+
+namespace
+{
+void add_to_impl(double* a, double const* b, std::size_t const size)
+{
+    using namespace mkn::avx;
+    AsymmetricSpan<double, Options::N<double>()> sa{a, size};
+    AsymmetricSpan<double const, Options::N<double>()> sb{b, size};
+    sa += sb;
+}
+
+} // namespace
+
+MKN_AVX_DISPATCH_REGISTER(add_to, add_to_impl);
+
+// constant initialised, so reading it runs nothing built for this tier
+Symbols const MKN_AVX_DISPATCH_CAT(symbols_, MKN_AVX_TIER){
+    mkn::avx::compiled_isa(),
+    reinterpret_cast<std::uintptr_t>(&mkn::avx::operator+<double, 2>),
+    reinterpret_cast<std::uintptr_t>(&mkn::avx::min<double, 2>),
+};
@@ -0,0 +1,2 @@
+// built with -mavx2 -mfma
+#include "kernels.ipp"
@@ -0,0 +1,2 @@
+// built without -m flags
+#include "kernels.ipp"
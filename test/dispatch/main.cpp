@@ -0,0 +1,59 @@
+
+#include "mkn/kul/log.hpp"
+#include "mkn/kul/alloc.hpp"
+#include "mkn/kul/assert.hpp"
+
+#include "kernels.hpp"
+
+#include <vector>
+#include <iostream>
+
+using namespace mkn::avx;
+
+// the tiers share no instantiation, else the linker may have kept the avx2
+// build of one and the scalar tier would call it
+void symbols()
+{
+    auto const& narrow = symbols_isa_none;
+    auto const& wide   = symbols_isa_avx2;
+
+    mkn::kul::abort_if_not(narrow.isa == ISA::NONE);
+    mkn::kul::abort_if_not(wide.isa == ISA::AVX2);
+    mkn::kul::abort_if_not(narrow.add != wide.add);
+    mkn::kul::abort_if_not(narrow.min != wide.min);
+}
+
+void kernels()
+{
+    std::size_t constexpr SIZE = 1003;
+    std::vector<double, mkn::kul::AlignedAllocator<double, 64>> a(SIZE, 1), b(SIZE, 2);
+
+    // each tier registered at its own tier
+    auto* const narrow = add_to.get(ISA::NONE);
+    auto* const wide   = add_to.get(ISA::AVX2);
+    mkn::kul::abort_if_not(narrow and wide and narrow != wide);
+
+    narrow(a.data(), b.data(), SIZE);
+    double expect = 3;
+    if (isa() >= ISA::AVX2)
+    {
+        wide(a.data(), b.data(), SIZE);
+        expect += 2;
+    }
+    add_to(a.data(), b.data(), SIZE);
+    expect += 2;
+
+    for (auto const& v : a)
+        mkn::kul::abort_if_not(v == expect);
+}
+
+int main() noexcept
+{
+    KOUT(NON) << __FILE__;
+    KOUT(NON) << "selected: " << to_string(add_to.selected());
+
+    symbols();
+    kernels();
+
+    return 0;
+}
@@ -0,0 +1,137 @@
+
+#include "mkn/kul/assert.hpp"
+
+#include "mkn/avx/lazy.hpp"
+#include "mkn/avx/arena.hpp"
+
+#include <iostream>
+
+using namespace mkn::avx;
+
+void bumps()
+{
+    Arena arena{1024};
+    auto const aligned = [](void const* p, std::size_t const a) {
+        return reinterpret_cast<std::uintptr_t>(p) % a == 0;
+    };
+
+    auto* p0 = arena.allocate(3, 1);
+    auto* p1 = arena.allocate(8, 8);
+    mkn::kul::abort_if_not(aligned(p1, 8) and static_cast<char*>(p1) - static_cast<char*>(p0) == 8);
+    mkn::kul::abort_if_not(aligned(arena.allocate(1), Options::ALIGN()));
+
+    auto const mark = arena.mark();
+    auto* p2        = arena.allocate(100);
+    arena.rewind(mark);
+    mkn::kul::abort_if_not(arena.allocate(100) == p2);
+
+    arena.allocate(2000); // past the chunk
+    arena.allocate(512);
+    mkn::kul::abort_if_not(arena.chunk_count() == 3);
+    auto const capacity = arena.capacity();
+
+    arena.release(); // merged
+    mkn::kul::abort_if_not(arena.chunk_count() == 1 and arena.capacity() == capacity);
+    arena.allocate(2000), arena.allocate(512);
+    mkn::kul::abort_if_not(arena.chunk_count() == 1);
+}
+
+void scopes()
+{
+    using V = Vector<double, ArenaAllocator<double>>;
+    static_assert(is_aligned<V>());
+
+    Arena arena{1 << 16};
+    mkn::kul::abort_if_not(Arena::current() == nullptr);
+    mkn::kul::abort_if_not(V(10).get_allocator().arena == nullptr);
+    {
+        Arena::Scope scope{arena};
+        mkn::kul::abort_if_not(Arena::current() == &arena);
+
+        V v(10, 1);
+        mkn::kul::abort_if_not(v.get_allocator().arena == &arena);
+        auto const mark = arena.mark();
+        {
+            Arena inner{256};
+            Arena::Scope nested{inner};
+            mkn::kul::abort_if_not(Arena::current() == &inner);
+            mkn::kul::abort_if_not(V(4).get_allocator().arena == &inner);
+        }
+        {
+            Arena::Scope nested{arena}; // released back to mark
+            V w(100, 2);
+        }
+        mkn::kul::abort_if_not(arena.mark().used == mark.used and v == V(10, 1));
+    }
+    mkn::kul::abort_if_not(Arena::current() == nullptr and arena.mark().used == 0);
+}
+
+// lazy graphs and eval results from the arena, the first step grows it and
+// later ones reuse the same memory
+void steps()
+{
+    using DV = std::vector<double, mkn::kul::AlignedAllocator<double, Options::ALIGN()>>;
+    std::size_t constexpr size = 1e4 + 3;
+
+    DV a0(size, 1), a1(size, 2), a2(size, 3);
+    Arena arena{1 << 12};
+    auto [l0, l1, l2] = lazy(arena, a0, a1, a2);
+
+    double const* data = nullptr;
+    std::size_t capacity = 0;
+    for (std::size_t step = 0; step < 4; ++step)
+    {
+        Arena::Scope scope{arena};
+        auto x = l0 * l1 + l2;
+        mkn::kul::abort_if_not(arena.mark().used > 0); // the graph
+        auto r = eval(x * l1 - sqrt(x), arena);
+        mkn::kul::abort_if_not(r.front() == 10 - std::sqrt(5.) and r.back() == r.front());
+
+        if (step > 1)
+            mkn::kul::abort_if_not(r.data() == data and arena.capacity() == capacity);
+        data = r.data(), capacity = arena.capacity();
+    }
+    mkn::kul::abort_if_not(arena.chunk_count() == 1);
+
+    auto const r = eval(l0 * l1 + l2, arena); // outside any scope, until released
+    mkn::kul::abort_if_not(r.front() == 5 and r.back() == 5);
+}
+
+// without an arena given, graphs are from the heap even in a scope, so they
+// can be built there and kept
+void ahead()
+{
+    using DV = std::vector<double, mkn::kul::AlignedAllocator<double, Options::ALIGN()>>;
+    std::size_t constexpr size = 1e3 + 3;
+
+    DV a0(size, 1), a1(size, 2);
+    auto [l0, l1] = lazy(a0, a1);
+
+    Arena arena{1 << 12};
+    std::vector<LazyVal<DV>> kept;
+    {
+        Arena::Scope scope{arena};
+        kept.emplace_back(l0 * l1 + l0 * l0 * l1 * l1 + l0 * l1 * l0 * l1); // past in_place
+        mkn::kul::abort_if_not(arena.mark().used == 0);
+        auto x = l0 * l1;
+        {
+            Arena other{1 << 12};
+            Arena::Scope nested{other};
+            kept.emplace_back(x - l1 * l1);
+            mkn::kul::abort_if_not(other.mark().used == 0);
+        }
+    }
+    auto const r0 = eval(kept[0]), r1 = eval(kept[1]);
+    mkn::kul::abort_if_not(r0.front() == 10 and r0.back() == 10);
+    mkn::kul::abort_if_not(r1.front() == -2 and r1.back() == -2);
+}
+
+int main()
+{
+    std::cout << __FILE__ << std::endl;
+    bumps();
+    scopes();
+    steps();
+    ahead();
+    return 0;
+}
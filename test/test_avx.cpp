@@ -6,7 +6,11 @@
 #include "mkn/avx/array.hpp"
 
 #include <cmath>
+#include <cfenv>
+#include <limits>
 #include <iostream>
+#include <algorithm>
+#include <functional>
 
 
 template<typename T>
@@ -63,6 +67,129 @@ void span()
 }
 
 
+// short rows, every tail length - checked against scalar
+template<typename T>
+void tails()
+{
+    constexpr auto N = mkn::avx::Span<T>::N;
+    for (std::size_t size = 1; size < N * 3; ++size)
+    {
+        mkn::avx::Vector<T> v0(size), v1(size), v2(size), r(size);
+        for (std::size_t i = 0; i < size; ++i)
+            v0[i] = i + 1, v1[i] = i + 2, v2[i] = i + 3;
+
+        auto [a, b, c, d] = mkn::avx::make_unknown_size_spans(r, v0, v1, v2);
+
+        a.add(b, c);
+        for (std::size_t i = 0; i < size; ++i)
+            mkn::kul::abort_if_not(r[i] == v0[i] + v1[i]);
+
+        a.fma(b, c, d);
+        for (std::size_t i = 0; i < size; ++i)
+            mkn::kul::abort_if_not(r[i] == v0[i] * v1[i] + v2[i]);
+
+        a.fms(b, c, d);
+        for (std::size_t i = 0; i < size; ++i)
+            mkn::kul::abort_if_not(r[i] == v0[i] * v1[i] - v2[i]);
+
+        a.fnma(b, c, d);
+        for (std::size_t i = 0; i < size; ++i)
+            mkn::kul::abort_if_not(r[i] == v2[i] - v0[i] * v1[i]);
+
+        a.sub(b, c);
+        a.min(a, d);
+        a.neg(a);
+        for (std::size_t i = 0; i < size; ++i)
+            mkn::kul::abort_if_not(r[i] == 1);
+        a.abs(a);
+        a.max(a, b);
+        for (std::size_t i = 0; i < size; ++i)
+            mkn::kul::abort_if_not(r[i] == v0[i]);
+
+        a.fma(b, c, d);
+        a -= d;
+        std::feclearexcept(FE_ALL_EXCEPT);
+        a /= c; // no 0 / 0 in the lanes past the tail
+        mkn::kul::abort_if_not(!std::fetestexcept(FE_INVALID));
+        for (std::size_t i = 0; i < size; ++i)
+            mkn::kul::abort_if_not(r[i] == v0[i]);
+
+        std::vector<T> u0(size + 1, 1), u1(size + 1, 2); // offset by one, unaligned
+        mkn::avx::UnSpan<T> ua{u0.data() + 1, size}, ub{u1.data() + 1, size};
+        ua += ub;
+        mkn::kul::abort_if_not(u0[0] == 1);
+        for (std::size_t i = 1; i < size + 1; ++i)
+            mkn::kul::abort_if_not(u0[i] == 3);
+    }
+}
+
+
+template<typename T>
+void reduce()
+{
+    using namespace mkn::avx;
+    constexpr auto N = Span<T>::N;
+
+    for (std::size_t size = 1; size < N * 9; ++size)
+    {
+        Vector<T> v0(size), v1(size);
+        T sum = 0, dot = 0, min = 1e9, max = -1e9;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            v0[i] = (i % 7) + 1, v1[i] = (i % 3) - 1.;
+            sum += v0[i], dot += v0[i] * v1[i];
+            min = std::min(min, v1[i] * v0[i]), max = std::max(max, v1[i] * v0[i]);
+            v1[i] *= v0[i];
+        }
+
+        auto [a, b] = make_unknown_size_spans(v0, v1);
+        mkn::kul::abort_if_not(a.sum() == sum);
+        mkn::kul::abort_if_not(a.template sum<Summation::KAHAN>() == sum);
+        mkn::kul::abort_if_not(b.min() == min);
+        mkn::kul::abort_if_not(b.max() == max);
+        mkn::kul::abort_if_not(a.norm() == std::sqrt(a.dot(a)));
+        for (std::size_t i = 0; i < size; ++i)
+            v1[i] /= v0[i];
+        mkn::kul::abort_if_not(a.dot(b) == dot);
+    }
+
+    { // exact multiple contract
+        Vector<T> v0(N * 8, 2);
+        auto a = make_span(v0);
+        mkn::kul::abort_if_not(a.sum() == N * 8 * 2);
+        mkn::kul::abort_if_not(a.dot(a) == N * 8 * 4);
+        v0[N * 3 + 1] = -3;
+        mkn::kul::abort_if_not(a.min() == -3 and a.max() == 2);
+    }
+
+    { // empty, and NaN as in the min/max instructions, the second operand
+        using L = std::numeric_limits<T>;
+        Vector<T> v0(0), v1(N + 1, 1);
+        auto [a] = make_unknown_size_spans(v0);
+        if constexpr (L::has_infinity)
+            mkn::kul::abort_if_not(a.min() == L::infinity() and a.max() == -L::infinity());
+        else
+            mkn::kul::abort_if_not(a.min() == L::max() and a.max() == L::lowest());
+        if constexpr (L::has_quiet_NaN and N > 1) // in the tail, last operand of the fold
+        {
+            v1[N]    = L::quiet_NaN();
+            auto [b] = make_unknown_size_spans(v1);
+            mkn::kul::abort_if_not(std::isnan(b.min()) and std::isnan(b.max()));
+        }
+    }
+
+    { // compensated stays on the exact sum where naive accumulation drifts
+        std::size_t constexpr size = 1e6 + 3;
+        Vector<T> v0(size, 0.1);
+        auto a          = make_unknown_size_span(v0);
+        double const ex = static_cast<double>(T{0.1}) * size;
+        auto const err  = [&](T const v) { return std::abs(static_cast<double>(v) - ex); };
+        mkn::kul::abort_if_not(err(a.template sum<Summation::KAHAN>()) <= err(a.sum()));
+        mkn::kul::abort_if_not(err(a.template sum<Summation::KAHAN>()) < ex * 1e-6);
+    }
+}
+
+
 template<typename T>
 void arr()
 {
@@ -81,7 +208,7 @@ void arr()
         a *= b;
 
         for (std::size_t i = 0; i < N; ++i)
-            mkn::kul::abort_if_not(v0[i] == ((i + 1) + 2) * (i + 2));
+            mkn::kul::abort_if_not(v0[i] == static_cast<T>(((i + 1) + 2) * (i + 2)));
     }
 
     Vec v0(N * 10, 2);
@@ -125,12 +252,369 @@ void fma()
     check(std::fma(a[0], a[1], a[2]));
 }
 
+// every lane op against scalar, lanes spread over the whole range of T
+template<typename T>
+void integers()
+{
+    using namespace mkn::avx;
+    using U          = std::make_unsigned_t<T>;
+    using AVX        = Type<T, Options::N<T>()>;
+    constexpr auto N = AVX::value_count;
+    constexpr int B  = sizeof(T) * 8;
+
+    AVX a, b, d;
+    std::uint64_t x = 88172645463325252ull;
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        x ^= x << 13, x ^= x >> 7, x ^= x << 17;
+        a[i] = static_cast<T>(x), b[i] = static_cast<T>(x >> B / 2), d[i] = (i % 9) + 1;
+    }
+    a[0] = std::numeric_limits<T>::min(), b[0] = std::numeric_limits<T>::max();
+
+    auto const check = [&](AVX const& r, auto const& fn) {
+        for (std::size_t i = 0; i < N; ++i)
+            mkn::kul::abort_if_not(r[i] == static_cast<T>(fn(a[i], b[i])));
+    };
+
+    check(a + b, [](U const p, U const q) { return p + q; });
+    check(a - b, [](U const p, U const q) { return p - q; });
+    check(a * b, [](U const p, U const q) { return std::uint64_t{p} * q; });
+    check(min(a, b), [](T const p, T const q) { return std::min(p, q); });
+    check(max(a, b), [](T const p, T const q) { return std::max(p, q); });
+    check(a & b, [](T const p, T const q) { return p & q; });
+    check(a | b, [](T const p, T const q) { return p | q; });
+    check(a ^ b, [](T const p, T const q) { return p ^ q; });
+    check(andnot(a, b), [](T const p, T const q) { return ~p & q; });
+    check(fma(a, b, a), [](U const p, U const q) { return std::uint64_t{p} * q + p; });
+    for (int const n : {0, 1, 3, B - 1})
+    {
+        check(a << n, [&](U const p, T) { return std::uint64_t{p} << n; });
+        check(a >> n, [&](T const p, T) { return p >> n; });
+    }
+    if constexpr (B <= 16)
+    {
+        using L = std::numeric_limits<T>;
+        auto const sat = [](int const v) { return std::clamp<int>(v, L::min(), L::max()); };
+        check(add_sat(a, b), [&](T const p, T const q) { return sat(p + q); });
+        check(sub_sat(a, b), [&](T const p, T const q) { return sat(p - q); });
+    }
+
+    auto const r = a / d;
+    for (std::size_t i = 0; i < N; ++i)
+        mkn::kul::abort_if_not(r[i] == static_cast<T>(a[i] / d[i]));
+
+    span<T>();
+    if constexpr (B > 8) // arr products overflow bytes
+        arr<T>();
+}
+
+// comparisons, select and masked updates against scalar, then on spans with tails
+template<typename T>
+void masks()
+{
+    using namespace mkn::avx;
+    using AVX        = Type<T, Options::N<T>()>;
+    constexpr auto N = AVX::value_count;
+
+    AVX a, b, x;
+    for (std::size_t i = 0; i < N; ++i)
+        a[i] = i % 5, b[i] = 2, x[i] = i + 1;
+
+    auto const check = [&](auto const& m, auto const& fn) {
+        auto const bits = movemask(m);
+        std::size_t n   = 0;
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            bool const on = fn(a[i], b[i]);
+            mkn::kul::abort_if_not(((bits >> i) & 1) == on);
+            n += on;
+        }
+        mkn::kul::abort_if_not(count(m) == n);
+        mkn::kul::abort_if_not(any(m) == (n > 0) and none(m) == (n == 0));
+        mkn::kul::abort_if_not(all(m) == (n == N));
+    };
+
+    check(a < b, [](T const p, T const q) { return p < q; });
+    check(a <= b, [](T const p, T const q) { return p <= q; });
+    check(a > b, [](T const p, T const q) { return p > q; });
+    check(a >= b, [](T const p, T const q) { return p >= q; });
+    check(a == b, [](T const p, T const q) { return p == q; });
+    check(a != b, [](T const p, T const q) { return p != q; });
+    check((a < b) | (a == b), [](T const p, T const q) { return p <= q; });
+    check((a <= b) & (a >= b), [](T const p, T const q) { return p == q; });
+    check((a <= b) ^ (a >= b), [](T const p, T const q) { return p != q; });
+    check(~(a > b), [](T const p, T const q) { return p <= q; });
+    check(a == a, [](T, T) { return true; });
+    check(~(a == a), [](T, T) { return false; });
+
+    if constexpr (std::is_unsigned_v<T>)
+    { // unsigned order past the signed range
+        T const max = std::numeric_limits<T>::max();
+        AVX big{Type_<T, N>::set_v(max)};
+        mkn::kul::abort_if_not(all(a < big) and none(big <= a));
+    }
+
+    auto const sel = select(a > b, x, a);
+    auto w0 = a, w1 = a, w2 = a;
+    where(a > b, w0) = x;
+    where(a > b, w1) += x;
+    where(a <= b, w2) *= x;
+    where(a == b, w2) = T{0};
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        bool const on = a[i] > b[i];
+        mkn::kul::abort_if_not(sel[i] == (on ? x[i] : a[i]));
+        mkn::kul::abort_if_not(w0[i] == sel[i]);
+        mkn::kul::abort_if_not(w1[i] == static_cast<T>(on ? a[i] + x[i] : a[i]));
+        mkn::kul::abort_if_not(w2[i] == static_cast<T>(a[i] == b[i] ? 0 : on ? a[i] : a[i] * x[i]));
+    }
+
+    for (std::size_t size = 1; size < N * 3 + 16; ++size)
+    {
+        mkn::avx::Vector<T> v0(size), v1(size), v2(size), r(size, 1);
+        for (std::size_t i = 0; i < size; ++i)
+            v0[i] = i % 5, v1[i] = 2, v2[i] = i % 7 + 1;
+
+        auto [s, p, q, u] = mkn::avx::make_unknown_size_spans(r, v0, v1, v2);
+
+        s.select(std::greater<>{}, p, q, u, p);
+        for (std::size_t i = 0; i < size; ++i)
+            mkn::kul::abort_if_not(r[i] == (v0[i] > v1[i] ? v2[i] : v0[i]));
+
+        s.add_if(std::less<>{}, p, q, u);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            T const e = v0[i] > v1[i] ? v2[i] : v0[i];
+            mkn::kul::abort_if_not(r[i] == static_cast<T>(v0[i] < v1[i] ? e + v2[i] : e));
+        }
+
+        s.select(std::equal_to<>{}, p, p, u, u); // r = v2
+        s.mul_if(std::greater_equal<>{}, p, q, q);
+        for (std::size_t i = 0; i < size; ++i)
+            mkn::kul::abort_if_not(r[i] == static_cast<T>(v0[i] >= v1[i] ? v2[i] * 2 : v2[i]));
+
+        std::size_t n = 0;
+        for (std::size_t i = 0; i < size; ++i)
+            n += v0[i] <= v1[i];
+        mkn::kul::abort_if_not(p.count_if(std::less_equal<>{}, q) == n);
+    }
+}
+
+// gather/scatter with repeated indices against scalar, then on spans with tails
+template<typename T>
+void indexed()
+{
+    using namespace mkn::avx;
+    using I          = detail::index_t<T>;
+    using AVX        = Type<T, Options::N<T>()>;
+    constexpr auto N = AVX::value_count;
+
+    std::vector<T> src(N * 4), dst(N * 4, 1), acc(N * 4, 1);
+    for (std::size_t i = 0; i < src.size(); ++i)
+        src[i] = i % 100;
+
+    AVX a;
+    Type<I, N> idx;
+    for (std::size_t i = 0; i < N; ++i)
+        a[i] = i + 1, idx[i] = (i * 7) % (N * 2); // repeats once N > 2
+
+    auto const g = gather(src.data(), idx);
+    scatter(dst.data(), idx, a);
+    scatter_add(acc.data(), idx, a);
+
+    std::vector<T> e_dst(N * 4, 1), e_acc(N * 4, 1);
+    for (std::size_t i = 0; i < N; ++i)
+    {
+        mkn::kul::abort_if_not(g[i] == src[idx[i]]);
+        e_dst[idx[i]] = a[i];
+        e_acc[idx[i]] += a[i];
+    }
+    mkn::kul::abort_if_not(dst == e_dst);
+    mkn::kul::abort_if_not(acc == e_acc);
+
+    I const three = 3;
+    AVX const x{AVX::set_v(src[3])};
+    Type<I, N> const same{Type<I, N>::set_v(three)};
+    scatter_add(acc.data(), same, x); // every lane conflicts
+    mkn::kul::abort_if_not(acc[3] == static_cast<T>(e_acc[3] + src[3] * N));
+
+    std::size_t const max = std::numeric_limits<I>::max(); // 8 bit lanes index 127
+    for (std::size_t size = 1; size < N * 3 + 16; ++size)
+    {
+        mkn::avx::Vector<T> r(size), v(size), out(size, 0), sum(size, 0);
+        mkn::avx::Vector<I> ix(size);
+        for (std::size_t i = 0; i < size; ++i)
+            v[i] = i % 11 + 1, ix[i] = (i * 5) % std::min<std::size_t>(size, max);
+
+        auto [sr, sv, so, ss] = mkn::avx::make_unknown_size_spans(r, v, out, sum);
+        auto si               = mkn::avx::make_unknown_size_span(ix);
+
+        sr.gather(sv, si);
+        sv.scatter(so, si);
+        sv.scatter_add(ss, si);
+
+        std::vector<T> e_out(size, 0), e_sum(size, 0);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            mkn::kul::abort_if_not(r[i] == v[ix[i]]);
+            e_out[ix[i]] = v[i];
+            e_sum[ix[i]] += v[i];
+        }
+        for (std::size_t i = 0; i < size; ++i)
+            mkn::kul::abort_if_not(out[i] == e_out[i] and sum[i] == e_sum[i]);
+    }
+
+    if constexpr (sizeof(T) < 4) // int32_t indices, past index_t
+    {
+        std::size_t constexpr size = (1 << 16) + 3;
+        mkn::avx::Vector<T> r(size), v(size), out(size, 0), sum(size, 0);
+        mkn::avx::Vector<std::int32_t> ix(size);
+        for (std::size_t i = 0; i < size; ++i)
+            v[i] = i % 11 + 1, ix[i] = (i * 5) % size;
+
+        auto [sr, sv, so, ss] = mkn::avx::make_unknown_size_spans(r, v, out, sum);
+        auto si               = mkn::avx::make_unknown_size_span(ix);
+
+        sr.gather(sv, si);
+        sv.scatter(so, si);
+        sv.scatter_add(ss, si);
+
+        std::vector<T> e_out(size, 0), e_sum(size, 0);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            mkn::kul::abort_if_not(r[i] == v[ix[i]]);
+            e_out[ix[i]] = v[i];
+            e_sum[ix[i]] += v[i];
+        }
+        for (std::size_t i = 0; i < size; ++i)
+            mkn::kul::abort_if_not(out[i] == e_out[i] and sum[i] == e_sum[i]);
+    }
+}
+
+// non-temporal writes match cached ones, unaligned spans fall back to cached
+template<typename T>
+void streaming()
+{
+    using namespace mkn::avx;
+    constexpr auto N = Span<T>::N;
+
+    for (std::size_t size = 1; size < N * 3 + 16; ++size)
+    {
+        mkn::avx::Vector<T> v0(size), v1(size), r0(size), r1(size);
+        for (std::size_t i = 0; i < size; ++i)
+            v0[i] = i % 13 + 2, v1[i] = i % 5 + 1;
+
+        auto [a, b, c, d] = mkn::avx::make_unknown_size_spans(v0, v1, r0, r1);
+        auto const same   = [&]() {
+            for (std::size_t i = 0; i < size; ++i)
+                mkn::kul::abort_if_not(r0[i] == r1[i]);
+        };
+
+        c.template add<Store::STREAM>(a, b), d.template add<Store::CACHE>(a, b), same();
+        c.template sub<Store::STREAM>(a, b), d.template sub<Store::CACHE>(a, b), same();
+        c.template mul<Store::STREAM>(a, b), d.template mul<Store::CACHE>(a, b), same();
+        c.template div<Store::STREAM>(a, b), d.template div<Store::CACHE>(a, b), same();
+        c.template copy<Store::STREAM>(v0);
+        mkn::kul::abort_if_not(r0 == v0);
+
+        if (size % N == 0)
+        {
+            auto [sa, sb, sc] = mkn::avx::make_spans(v0, v1, r0);
+            sc.template mul<Store::STREAM>(sa, sb);
+            for (std::size_t i = 0; i < size; ++i)
+                mkn::kul::abort_if_not(r0[i] == static_cast<T>(v0[i] * v1[i]));
+        }
+
+        std::vector<T> u(size + 1, 0); // offset by one, unaligned
+        auto e = mkn::avx::make_unknown_size_span(u, 1, size);
+        e.template copy<Store::STREAM>(v1);
+        for (std::size_t i = 0; i < size; ++i)
+            mkn::kul::abort_if_not(u[i + 1] == v1[i]);
+    }
+}
+
+// avx512 only ops against scalar
+template<typename T>
+void avx512()
+{
+    using namespace mkn::avx;
+    if constexpr (Options::AVX512)
+    {
+        using AVX        = Type<T, Options::N<T>()>;
+        constexpr auto N = AVX::value_count;
+        auto const m     = static_cast<mask_t<T, N>>(0x9a5c3f17e6b2d4a1ull);
+        auto const on    = [&](std::size_t const i) { return (m >> i) & 1; };
+
+        AVX a, b, c;
+        Type<detail::index_t<T>, N> idx;
+        for (std::size_t i = 0; i < N; ++i)
+            a[i] = i + 1, b[i] = i % 7, c[i] = 3, idx[i] = N - 1 - i;
+
+        auto const packed = compress(a, m);
+        std::size_t j     = 0;
+        for (std::size_t i = 0; i < N; ++i)
+            if (on(i))
+                mkn::kul::abort_if_not(packed[j++] == a[i]);
+        for (std::size_t i = j; i < N; ++i)
+            mkn::kul::abort_if_not(packed[i] == 0);
+
+        auto const spread = expand(packed, m);
+        for (std::size_t i = 0; i < N; ++i)
+            mkn::kul::abort_if_not(spread[i] == (on(i) ? a[i] : 0));
+
+        std::vector<T> out(N + 1, 7);
+        mkn::kul::abort_if_not(compress_store(out.data(), a, m) == j);
+        for (std::size_t i = 0; i < N + 1; ++i)
+            mkn::kul::abort_if_not(out[i] == (i < j ? packed[i] : 7));
+
+        auto const reversed = permute(idx, a);
+        auto const added    = mask_add(c, m, a, b);
+        auto const muled    = mask_mul(c, m, a, b);
+        auto const same     = ternarylogic<0x96>(a, b, a); // a ^ b ^ a
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            mkn::kul::abort_if_not(reversed[i] == a[N - 1 - i]);
+            mkn::kul::abort_if_not(added[i] == (on(i) ? static_cast<T>(a[i] + b[i]) : 3));
+            mkn::kul::abort_if_not(muled[i] == (on(i) ? static_cast<T>(a[i] * b[i]) : 3));
+            mkn::kul::abort_if_not(same[i] == b[i]);
+        }
+
+        if constexpr (std::is_floating_point_v<T>)
+        {
+            AVX const one{Type_<T, N>::set_v(1)}, two{Type_<T, N>::set_v(2)};
+            AVX const tiny{Type_<T, N>::set_v(std::numeric_limits<T>::denorm_min())};
+            mkn::kul::abort_if_not(add_round<Rounding::DOWN>(one, tiny)[0] == 1);
+            mkn::kul::abort_if_not(add_round<Rounding::UP>(one, tiny)[0] > 1);
+            mkn::kul::abort_if_not(sub_round<Rounding::ZERO>(one, tiny)[0] < 1);
+            mkn::kul::abort_if_not(mul_round<Rounding::NEAREST>(two, two)[0] == 4);
+            auto const up   = div_round<Rounding::UP>(one, a);
+            auto const down = div_round<Rounding::DOWN>(one, a);
+            for (std::size_t i = 2; i < N; i += 2) // 1 / odd is never exact
+                mkn::kul::abort_if_not(up[i] > down[i] and up[i] - down[i] < 1e-6);
+            auto const root = sqrt_round<Rounding::UP>(two)[0];
+            mkn::kul::abort_if_not(root > sqrt_round<Rounding::DOWN>(two)[0]);
+            mkn::kul::abort_if_not(fma_round<Rounding::NEAREST>(a, b, c)[1] == 2 * 1 + 3);
+        }
+        else
+        {
+            auto const sel = ternarylogic<0xCA>(a, b, c); // a ? b : c, bitwise
+            for (std::size_t i = 0; i < N; ++i)
+                mkn::kul::abort_if_not(sel[i] == static_cast<T>((a[i] & b[i]) | (~a[i] & c[i])));
+        }
+    }
+}
+
 template<typename T>
 void test()
 {
     array<T>();
     span<T>();
+    tails<T>();
+    reduce<T>();
     arr<T>();
+    masks<T>();
+    indexed<T>();
+    streaming<T>();
 }
 
 int main() noexcept
@@ -138,6 +622,36 @@ int main() noexcept
     std::cout << __FILE__ << std::endl;
     test<float>();
     test<double>();
+    integers<std::int8_t>();
+    integers<std::uint8_t>();
+    integers<std::int16_t>();
+    integers<std::uint16_t>();
+    integers<std::int32_t>();
+    integers<std::uint32_t>();
+    integers<std::int64_t>();
+    integers<std::uint64_t>();
+    masks<std::int8_t>();
+    masks<std::uint8_t>();
+    masks<std::int16_t>();
+    masks<std::uint16_t>();
+    masks<std::int32_t>();
+    masks<std::uint32_t>();
+    masks<std::int64_t>();
+    masks<std::uint64_t>();
+    indexed<std::int8_t>();
+    indexed<std::uint16_t>();
+    indexed<std::int32_t>();
+    indexed<std::uint32_t>();
+    indexed<std::int64_t>();
+    indexed<std::uint64_t>();
+    streaming<std::uint8_t>();
+    streaming<std::int32_t>();
+    avx512<float>();
+    avx512<double>();
+    avx512<std::int8_t>();
+    avx512<std::uint16_t>();
+    avx512<std::int32_t>();
+    avx512<std::uint64_t>();
 
     return 0;
 }
@@ -0,0 +1,90 @@
+
+#include "mkn/kul/log.hpp"
+#include "mkn/kul/assert.hpp"
+
+#include "mkn/avx.hpp"
+#include "mkn/avx/dispatch.hpp"
+
+#include <iostream>
+
+using namespace mkn::avx;
+
+using Kernel_t = ISA(std::size_t&);
+
+template<ISA tier>
+ISA kernel(std::size_t& calls)
+{
+    ++calls;
+    return tier;
+}
+
+void detect()
+{
+    // a binary only runs where its compiled tier is supported
+    mkn::kul::abort_if_not(detect_isa() >= compiled_isa());
+    mkn::kul::abort_if_not(isa() <= detect_isa());
+
+    mkn::kul::abort_if_not(lanes<double>(ISA::NONE) == 1);
+    mkn::kul::abort_if_not(lanes<double>(ISA::AVX) == 2);
+    mkn::kul::abort_if_not(lanes<float>(ISA::AVX2) == 8);
+    mkn::kul::abort_if_not(lanes<double>(ISA::AVX512) == 8);
+    mkn::kul::abort_if_not(lanes<double>(compiled_isa()) == Options::N<double>());
+}
+
+void dispatch()
+{
+    std::size_t calls = 0;
+
+    Dispatch<Kernel_t> table;
+    table.set(ISA::NONE, kernel<ISA::NONE>);
+    mkn::kul::abort_if_not(table(calls) == ISA::NONE);
+
+    table.set(ISA::AVX, kernel<ISA::AVX>)
+        .set(ISA::AVX2, kernel<ISA::AVX2>)
+        .set(ISA::AVX512, kernel<ISA::AVX512>);
+
+    // every tier registered, so the widest supported wins
+    mkn::kul::abort_if_not(table.selected() == isa());
+    mkn::kul::abort_if_not(table(calls) == isa());
+    mkn::kul::abort_if_not(calls == 2);
+}
+
+void missing()
+{
+    Dispatch<Kernel_t> table;
+    try
+    {
+        table.selected();
+    }
+    catch (mkn::avx::Exception const&)
+    {
+        return;
+    }
+    std::abort();
+}
+
+inline constinit Dispatch<Kernel_t> registered{};
+MKN_AVX_DISPATCH_REGISTER(registered, kernel<compiled_isa()>);
+
+void registration()
+{
+    std::size_t calls = 0;
+    if (isa() < compiled_isa()) // capped by MKN_AVX_ISA
+        return;
+    mkn::kul::abort_if_not(registered.selected() == compiled_isa());
+    mkn::kul::abort_if_not(registered(calls) == compiled_isa());
+}
+
+int main() noexcept
+{
+    KOUT(NON) << __FILE__;
+    KOUT(NON) << "detected: " << to_string(detect_isa()) << " compiled: "
+              << to_string(compiled_isa());
+
+    detect();
+    dispatch();
+    missing();
+    registration();
+
+    return 0;
+}
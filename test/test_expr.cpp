@@ -0,0 +1,101 @@
+
+#include "mkn/kul/log.hpp"
+#include "mkn/kul/assert.hpp"
+
+#include "mkn/avx.hpp"
+#include "mkn/avx/expr.hpp"
+
+#include <cmath>
+#include <cfenv>
+#include <random>
+#include <iostream>
+
+using namespace mkn::avx;
+
+template<typename T>
+void contraction()
+{
+    using L = expr::Leaf<T>;
+    Vector<T> v0(4), v1(4), v2(4);
+    auto [a, b, c] = fused(v0, v1, v2);
+
+    static_assert(std::is_same_v<decltype(a * b + c), expr::Node<expr::Fma, L, L, L>>);
+    static_assert(std::is_same_v<decltype(c + a * b), expr::Node<expr::Fma, L, L, L>>);
+    static_assert(std::is_same_v<decltype(a * b - c), expr::Node<expr::Fms, L, L, L>>);
+    static_assert(std::is_same_v<decltype(c - a * b), expr::Node<expr::Fnma, L, L, L>>);
+    static_assert(
+        std::is_same_v<decltype(a * 2 + c), expr::Node<expr::Fma, L, expr::Scalar<T>, L>>);
+    static_assert(std::is_same_v<decltype((a + b) * c),
+                                 expr::Node<expr::Mul, expr::Node<expr::Add, L, L>, L>>);
+}
+
+// every tail length and a large size, checked against a scalar loop
+template<typename T>
+void values()
+{
+    std::size_t constexpr N = Options::N<T>();
+    for (std::size_t const size : {std::size_t{1}, N + 1, 2 * N, 3 * N - 1, std::size_t(1e6 + 3)})
+    {
+        Vector<T> v0(size), v1(size), v2(size), v3(size);
+        for (std::size_t i = 0; i < size; ++i)
+            v0[i] = i % 7 + 1, v1[i] = i % 5 + 2, v2[i] = i % 3 + 3, v3[i] = 4;
+
+        auto [a, b, c, d] = fused(v0, v1, v2, v3);
+        auto const check  = [&](auto const& r, auto const& fn) {
+            mkn::kul::abort_if_not(r.size() == size);
+            for (std::size_t i = 0; i < size; ++i)
+                mkn::kul::abort_if_not(r[i] == fn(v0[i], v1[i], v2[i], v3[i]));
+        };
+
+        check(eval(a + b), [](T x, T y, T, T) { return x + y; });
+        check(eval(a * b + c), [](T x, T y, T z, T) { return x * y + z; });
+        check(eval(c - a * b), [](T x, T y, T z, T) { return z - x * y; });
+        check(eval(a * b - c * d), [](T x, T y, T z, T w) { return x * y - z * w; });
+        std::feclearexcept(FE_ALL_EXCEPT);
+        check(eval((a + b) * (c - d) / d),
+              [](T x, T y, T z, T w) { return (x + y) * (z - w) / w; });
+        mkn::kul::abort_if_not(!std::fetestexcept(FE_INVALID)); // no 0 / 0 past the tail
+        check(eval(2 * a + b * 3 - 1), [](T x, T y, T, T) { return 2 * x + y * 3 - 1; });
+        check(eval(a * b + c * d + a), [](T x, T y, T z, T w) { return x * y + z * w + x; });
+
+        // in place, the destination is a leaf
+        eval_into(v0, a * b + a);
+        for (std::size_t i = 0; i < size; ++i)
+            mkn::kul::abort_if_not(v0[i] == (i % 7 + 1) * (i % 5 + 3));
+    }
+}
+
+// contracted nodes round once when the cpu has fma
+template<typename T>
+void fused_rounding()
+{
+    std::size_t constexpr SIZE = 1001;
+    std::mt19937_64 gen{3};
+    std::uniform_real_distribution<T> dist{-1, 1};
+
+    Vector<T> v0(SIZE), v1(SIZE), v2(SIZE);
+    for (std::size_t i = 0; i < SIZE; ++i)
+        v0[i] = dist(gen), v1[i] = dist(gen), v2[i] = dist(gen);
+
+    auto [a, b, c] = fused(v0, v1, v2);
+    auto const r   = eval(a * b + c);
+    for (std::size_t i = 0; i < SIZE; ++i)
+    {
+        T const want = Options::FMA ? std::fma(v0[i], v1[i], v2[i]) : v0[i] * v1[i] + v2[i];
+        mkn::kul::abort_if_not(r[i] == want);
+    }
+}
+
+int main() noexcept
+{
+    KOUT(NON) << __FILE__;
+
+    contraction<float>();
+    contraction<double>();
+    values<float>();
+    values<double>();
+    fused_rounding<float>();
+    fused_rounding<double>();
+
+    return 0;
+}
@@ -0,0 +1,163 @@
+
+#include "mkn/kul/log.hpp"
+#include "mkn/kul/assert.hpp"
+
+#include "mkn/avx/jit.hpp"
+
+#include <random>
+
+using namespace mkn::avx;
+
+constexpr static std::size_t N = 1e3 + 5;
+
+template<typename T>
+using AV = std::vector<T, mkn::kul::AlignedAllocator<T, Options::ALIGN()>>;
+
+template<typename T>
+void expressions(jit::Cache& cache)
+{
+    AV<T> a0(N, 1), a1(N, 2), a2(N, 3), a3(N, 4), a4(N, 5);
+    auto [l0, l1, l2, l3, l4] = lazy(a0, a1, a2, a3, a4);
+
+    auto const check = [](auto const& r, T const v) {
+        mkn::kul::abort_if_not(r.size() == N and r.front() == v and r.back() == v);
+    };
+
+    check(jit::eval(l0 + l1 + l0, cache), 4);
+    check(jit::eval(l0 * l1 + l2, cache), 5);
+    check(jit::eval(l0 + l1 * l2, cache), 7);
+    check(jit::eval(l0 * l1 + l2 + l0, cache), 6);
+    check(jit::eval(l0 * l1 + l2 * l3 + l4, cache), 19);
+    check(jit::eval(l0 * l1 + l2 * l3 + l4 * l1 + l2 * l3 + l4 * l1, cache), 46);
+    check(jit::eval(l0 - l1 * l2, cache), -5);
+    check(jit::eval(2 * l0 + l1 / 4.0, cache), 2.5);
+    check(jit::eval(1 - l1 * l2, cache), -5);
+    check(jit::eval(l4 / l1 - l0, cache), 1.5);
+    check(jit::eval(sqrt(l3 * l3 + l2 * l2), cache), 5);
+    check(jit::eval(max(l4 - l2, -l1) + abs(l0 - l3), cache), 5);
+    check(jit::eval(clamp(l4, l0, l3), cache), 4);
+    check(jit::eval((l1 + l2) * (l1 - l2) + l1, cache), -3);
+}
+
+void caching(std::filesystem::path const& dir)
+{
+    AV<double> a0(N, 1), a1(N, 2), a2(N, 3);
+    {
+        jit::Cache cache{dir};
+        auto [l0, l1, l2] = lazy(a0, a1, a2);
+        auto r            = jit::eval(l0 * l1 - l2, cache);
+        mkn::kul::abort_if_not(r.back() == -1 and cache.compiled() == 1);
+
+        // same structure, different inputs
+        a0.assign(N, 3);
+        r = jit::eval(l2 * l1 - l0, cache);
+        mkn::kul::abort_if_not(r.back() == 3 and cache.compiled() == 1);
+    }
+    {
+        jit::Cache cache{dir}; // from disk
+        auto [l0, l1, l2] = lazy(a0, a1, a2);
+        auto r            = jit::eval(l0 * l1 - l2, cache);
+        mkn::kul::abort_if_not(r.back() == 3 and cache.compiled() == 0);
+    }
+
+    // another source under the same key is not loaded, a second object is built
+    for (auto const& entry : std::filesystem::directory_iterator{dir})
+        if (entry.path().extension() == ".cpp")
+            std::ofstream{entry.path()} << "collision";
+    {
+        jit::Cache cache{dir};
+        auto [l0, l1, l2] = lazy(a0, a1, a2);
+        auto r            = jit::eval(l0 * l1 - l2, cache);
+        mkn::kul::abort_if_not(r.back() == 3 and cache.compiled() == 1);
+    }
+    std::size_t objects = 0;
+    for (auto const& entry : std::filesystem::directory_iterator{dir})
+        objects += entry.path().extension() == ".so";
+    mkn::kul::abort_if_not(objects == 2);
+    {
+        jit::Cache cache{dir}; // the second object from disk
+        auto [l0, l1, l2] = lazy(a0, a1, a2);
+        auto r            = jit::eval(l0 * l1 - l2, cache);
+        mkn::kul::abort_if_not(r.back() == 3 and cache.compiled() == 0);
+    }
+}
+
+void failure(std::filesystem::path const& dir)
+{
+    AV<double> a0(N, 1), a1(N, 2);
+    jit::Cache cache{dir, "false"};
+    auto [l0, l1] = lazy(a0, a1);
+
+    bool threw = false;
+    try
+    {
+        jit::eval(l0 + l1, cache);
+    }
+    catch (Exception const&)
+    {
+        threw = true;
+    }
+    mkn::kul::abort_if_not(threw);
+}
+
+void untrusted(std::filesystem::path const& dir)
+{
+    namespace fs = std::filesystem;
+    AV<double> a0(N, 1), a1(N, 2);
+    auto [l0, l1] = lazy(a0, a1);
+
+    auto const refused = [&](fs::path const& d) {
+        jit::Cache cache{d};
+        try
+        {
+            jit::eval(l0 + l1, cache);
+        }
+        catch (Exception const&)
+        {
+            return cache.compiled() == 0;
+        }
+        return false;
+    };
+
+    fs::create_directories(dir / "open");
+    fs::permissions(dir / "open", fs::perms::all);
+    mkn::kul::abort_if_not(refused(dir / "open"));
+
+    { // a world writable object planted under a known name
+        jit::Cache cache{dir / "planted"};
+        jit::eval(l0 + l1, cache);
+        mkn::kul::abort_if_not((fs::status(dir / "planted").permissions() & fs::perms::all)
+                               == fs::perms::owner_all);
+    }
+    for (auto const& entry : fs::directory_iterator{dir / "planted"})
+        if (entry.path().extension() == ".so")
+            fs::permissions(entry.path(), fs::perms::all);
+    mkn::kul::abort_if_not(refused(dir / "planted"));
+}
+
+int main() noexcept
+{
+    KOUT(NON) << __FILE__;
+
+#if defined(_WIN32)
+    return 0; // jit::Cache is POSIX only
+#else
+    if (std::system(nullptr) == 0)
+        return 0; // no shell to run the compiler
+
+    auto const dir = std::filesystem::temp_directory_path()
+                   / ("mkn.avx.jit.test." + std::to_string(std::random_device{}()));
+    std::filesystem::remove_all(dir);
+    {
+        jit::Cache cache{dir};
+        expressions<float>(cache);
+        expressions<double>(cache);
+    }
+    caching(dir / "caching");
+    failure(dir / "failure");
+    untrusted(dir / "untrusted");
+    std::filesystem::remove_all(dir);
+
+    return 0;
+#endif
+}
@@ -2,10 +2,39 @@
 #include "mkn/avx/lazy.hpp"
 #include "mkn/kul/assert.hpp"
 
+#include <new>
+#include <atomic>
+#include <thread>
+#include <cstdlib>
+#include <numeric>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
 using namespace mkn::avx;
 
 constexpr static std::size_t N = 1e6 + 5;
 
+// global operator new calls, see plan
+static std::atomic<std::size_t> news = 0;
+void* operator new(std::size_t const n)
+{
+    ++news;
+    if (auto* const p = std::malloc(n ? n : 1))
+        return p;
+    throw std::bad_alloc{};
+}
+void operator delete(void* const p) noexcept
+{
+    std::free(p);
+}
+void operator delete(void* const p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
 void add()
 {
     using DV = std::vector<double, mkn::kul::AlignedAllocator<double, Options::ALIGN()>>;
@@ -105,6 +134,509 @@ void fn1()
     mkn::kul::abort_if_not(r.front() == 41 and r.back() == 41);
 }
 
+// integer lanes, without the floating point only functions
+template<typename T>
+void integers()
+{
+    using IV = std::vector<T, mkn::kul::AlignedAllocator<T, Options::ALIGN()>>;
+    for (std::size_t const size : {std::size_t{1}, std::size_t{13}, N})
+    {
+        IV a0(size, 2), a1(size, 3), a2(size, 7);
+        auto [l0, l1, l2] = lazy(a0, a1, a2);
+
+        auto r = eval(l0 * l1 + l0);
+        mkn::kul::abort_if_not(r.front() == 8 and r.back() == 8);
+        r = eval(min(l2 - l0 * l1, l1) * 2 - max(l0, l1));
+        mkn::kul::abort_if_not(r.front() == -1 and r.back() == -1);
+        mkn::kul::abort_if_not(sum(l0 * l1) == static_cast<T>(6 * size));
+    }
+}
+
+void contract()
+{
+    using DV = std::vector<double, mkn::kul::AlignedAllocator<double, Options::ALIGN()>>;
+    DV a0(N, 1), a1(N, 2), a2(N, 3);
+    auto [l0, l1, l2] = lazy(a0, a1, a2);
+    {
+        auto lz = l0 * l1 + l2;
+        LazyEvaluator<decltype(lz)> evaluator{lz};
+        evaluator.compile();
+        auto const fused = Options::FMA; // a mul then an add without
+        mkn::kul::abort_if_not(evaluator.instrs.size() == (fused ? 1 : 2) and evaluator.slots == 0);
+        mkn::kul::abort_if_not(evaluator.instrs.back().code
+                               == (fused ? LazyCode::FMA : LazyCode::ADD));
+    }
+    {
+        auto lz = l0 + l1 * l2 - l2 * l1;
+        LazyEvaluator<decltype(lz)> evaluator{lz};
+        evaluator.compile();
+        auto const fused = Options::FMA; // the shared mul is a tmp without
+        mkn::kul::abort_if_not(evaluator.instrs.size() == (fused ? 2 : 3)
+                               and evaluator.slots == (fused ? 0 : 1));
+    }
+
+    auto r = eval(l0 * l1 - l2);
+    mkn::kul::abort_if_not(r.front() == -1 and r.back() == -1);
+    r = eval(l0 - l1 * l2);
+    mkn::kul::abort_if_not(r.front() == -5 and r.back() == -5);
+    r = eval(l0 * l1 + l2 * l1);
+    mkn::kul::abort_if_not(r.front() == 8 and r.back() == 8);
+}
+
+void cse()
+{
+    using DV = std::vector<double, mkn::kul::AlignedAllocator<double, Options::ALIGN()>>;
+    DV a0(N, 1), a1(N, 4), a2(N, 2), a3(N, 6), a4(N, 3);
+    auto [l0, l1, l2, l3, l4] = lazy(a0, a1, a2, a3, a4);
+
+    auto const count = [](auto const& evaluator, LazyCode const code) {
+        return std::count_if(evaluator.instrs.begin(), evaluator.instrs.end(),
+                             [&](auto const& in) { return in.code == code; });
+    };
+    {
+        auto lz = l0 + l1 / l2 + l1 / l2;
+        LazyEvaluator<decltype(lz)> evaluator{lz};
+        evaluator.compile();
+        mkn::kul::abort_if_not(count(evaluator, LazyCode::DIV) == 1 and evaluator.slots == 1);
+    }
+    {
+        auto lz = l0 * l1 + l2 * l3 + l4 * l1 + l2 * l3 + l4 * l1;
+        LazyEvaluator<decltype(lz)> evaluator{lz};
+        evaluator.compile();
+        if constexpr (Options::FMA)
+            mkn::kul::abort_if_not(count(evaluator, LazyCode::MUL) <= 1 and evaluator.slots == 0);
+        else // each distinct mul once, two held for a second use
+            mkn::kul::abort_if_not(count(evaluator, LazyCode::MUL) == 3 and evaluator.slots == 2);
+    }
+    {
+        auto lz = l0 + l1 / l2 + l3 / l4 + l1 / l4 + l3 / l2;
+        LazyEvaluator<decltype(lz)> evaluator{lz};
+        evaluator.compile();
+        mkn::kul::abort_if_not(evaluator.instrs.size() == 8 and evaluator.slots == 1);
+    }
+
+    auto r = eval(l0 + l1 / l2 + l1 / l2);
+    mkn::kul::abort_if_not(r.front() == 5 and r.back() == 5);
+    r = eval(l0 + l1 / l2 + l3 / l4 + l1 / l4 + l3 / l2);
+    mkn::kul::abort_if_not(std::abs(r.back() - (1 + 2 + 2 + 4. / 3 + 3)) < 1e-12);
+}
+
+void broadcast()
+{
+    using DV = std::vector<double, mkn::kul::AlignedAllocator<double, Options::ALIGN()>>;
+    auto constexpr W = Options::N<double>();
+
+    DV a0(N, 1), a1(N, 2);
+    auto [l0, l1] = lazy(a0, a1);
+    {
+        auto lz = 2.0 * l0 + l1;
+        LazyEvaluator<decltype(lz)> evaluator{lz};
+        evaluator.compile();
+        auto const fused = Options::FMA;
+        mkn::kul::abort_if_not(evaluator.instrs.size() == (fused ? 1 : 2)
+                               and evaluator.consts.size() == 1);
+        mkn::kul::abort_if_not(evaluator.instrs.back().code
+                               == (fused ? LazyCode::FMA : LazyCode::ADD));
+    }
+    {
+        auto lz = l0 * 2.0 + l1 * 2;
+        LazyEvaluator<decltype(lz)> evaluator{lz};
+        evaluator.compile();
+        mkn::kul::abort_if_not(evaluator.consts.size() == 1);
+    }
+
+    auto const check = [](auto const& r, double const v) {
+        mkn::kul::abort_if_not(r.front() == v and r.back() == v);
+    };
+    check(eval(2.0 * l0 + l1), 4);
+    check(eval(l1 - 1.0), 1);
+    check(eval(1.0 - l1), -1);
+    check(eval(8.0 / l1), 4);
+    check(eval(l1 / 2.f), 1);
+    check(eval(l0 + 3 * l1), 7);
+    check(eval(l0 - l1 * 0.5), 0);
+
+    Array<double, W> arr;
+    for (std::size_t i = 0; i < W; ++i)
+        arr[i] = i;
+    for (std::size_t size = 1; size < 50; ++size)
+    {
+        DV b0(size, 1), b1(size, 2);
+        auto [m0, m1] = lazy(b0, b1);
+        auto r        = eval(m0 * arr + m1 - 1.0);
+        for (std::size_t i = 0; i < size; ++i)
+            mkn::kul::abort_if_not(r[i] == i % W + 1);
+    }
+}
+
+void parallel()
+{
+    using DV = std::vector<double, mkn::kul::AlignedAllocator<double, Options::ALIGN()>>;
+    ThreadPool pool{4};
+    auto const policy = par.on(pool).min_bytes_per_thread(1 << 12);
+
+    for (std::size_t const size : {std::size_t{1}, std::size_t{100}, N})
+    {
+        DV a0(size), a1(size, 2), a2(size, 3);
+        for (std::size_t i = 0; i < size; ++i)
+            a0[i] = i % 7;
+        auto [l0, l1, l2] = lazy(a0, a1, a2);
+
+        auto const expect = eval(l0 * l1 + l2 / l1 - 0.5 * l2 * l1, seq);
+
+        Partition p;
+        auto const r = eval(l0 * l1 + l2 / l1 - 0.5 * l2 * l1, policy.report_to(p));
+        mkn::kul::abort_if_not(r == expect);
+        if (size == N)
+            mkn::kul::abort_if_not(p.threads() == 4);
+    }
+}
+
+void plan()
+{
+    using DV = std::vector<double, mkn::kul::AlignedAllocator<double, Options::ALIGN()>>;
+    DV a0(N, 1), a1(N, 2), a2(N, 3), b0(N, 4), r(N), q(N);
+    auto [l0, l1, l2] = lazy(a0, a1, a2);
+
+    LazyPlan plan{l0 * l1 + l2 * 2.0};
+
+    for (std::size_t step = 0; step < 3; ++step)
+    {
+        plan(r);
+        mkn::kul::abort_if_not(r.front() == 8 and r.back() == 8);
+    }
+
+    a2.assign(N, 1);
+    plan(r.data());
+    mkn::kul::abort_if_not(r.front() == 4 and r.back() == 4);
+
+    plan.bind(a0, b0)(r); // the result operand
+    mkn::kul::abort_if_not(r.front() == 10 and r.back() == 10);
+    plan.bind(a1, b0)(r);
+    mkn::kul::abort_if_not(r.front() == 18 and r.back() == 18);
+
+    ThreadPool pool{3};
+    plan(q, par.on(pool).min_bytes_per_thread(1 << 12));
+    mkn::kul::abort_if_not(q == r);
+
+    { // in place, a2 is read after the result is written, nothing allocated per call
+        DV c0(N, 1), c1(N, 2), c2(N, 3);
+        auto [m0, m1, m2] = lazy(c0, c1, c2);
+        LazyPlan inplace{(m0 + m1) * m2 + m2};
+        inplace(c2);
+        mkn::kul::abort_if_not(c2.front() == 12 and c2.back() == 12);
+        auto const before = news.load();
+        for (std::size_t step = 0; step < 3; ++step)
+            inplace(c2);
+        mkn::kul::abort_if_not(news == before);
+        mkn::kul::abort_if_not(c2.front() == 12 * 64 and c2.back() == 12 * 64);
+    }
+
+    auto const e = eval(l0 + l1); // other expressions are unaffected
+    mkn::kul::abort_if_not(e.front() == 3 and e.back() == 3);
+}
+
+// expressions own their ops, they can be kept, reused, built interleaved or
+// on many threads at once
+void graphs()
+{
+    using DV = std::vector<double, mkn::kul::AlignedAllocator<double, Options::ALIGN()>>;
+    DV a0(N, 1), a1(N, 2), a2(N, 3);
+    auto [l0, l1, l2] = lazy(a0, a1, a2);
+
+    auto const check = [](auto const& r, double const v) {
+        mkn::kul::abort_if_not(r.front() == v and r.back() == v);
+    };
+    check(eval(l0 * (l0 + l1)), 3);
+    check(eval((l0 + l1) * (l0 - l1)), -3);
+    check(eval(l2 - (l1 - l0) * l2), 0);
+
+    auto x = l0 * l1 + l2; // 5
+    auto y = l2 - l1;      // 1
+    check(eval(x + x * l1), 15);
+    check(eval(x * y - x), 0);
+    check(eval(sqrt(x - y) * x), 10);
+    check(eval(x), 5);
+
+    LazyPlan plan{x / (y + 1.0)};
+    check(eval(y), 1); // nested, while plan is held
+    DV r(N);
+    plan(r);
+    check(r, 2.5);
+
+    std::vector<decltype(x)> exprs;
+    for (std::size_t i = 0; i < 4; ++i)
+        exprs.emplace_back(x * static_cast<double>(i) - y);
+    std::vector<DV> rs(exprs.size(), DV(N));
+    std::vector<std::thread> threads;
+    for (std::size_t i = 0; i < exprs.size(); ++i)
+        threads.emplace_back([&, i]() {
+            eval_into(rs[i], exprs[i]);
+            mkn::kul::abort_if_not(eval(exprs[i] + x).back() == 5. * i + 4);
+        });
+    for (auto& thread : threads)
+        thread.join();
+    for (std::size_t i = 0; i < rs.size(); ++i)
+        check(rs[i], 5. * i - 1);
+}
+
+void into()
+{
+    using DV = std::vector<double, mkn::kul::AlignedAllocator<double, Options::ALIGN()>>;
+    for (std::size_t const size : {std::size_t{3}, std::size_t{100}, N})
+    {
+        DV a0(size), a1(size, 2), a2(size, 3), r(size);
+        for (std::size_t i = 0; i < size; ++i)
+            a0[i] = i % 7;
+        auto [l0, l1, l2] = lazy(a0, a1, a2);
+
+        // l2 is read after the result is first written
+        auto const expect = eval((l0 + l1) * (l2 * l0) + l2);
+        mkn::kul::abort_if_not(&eval_into(r, (l0 + l1) * (l2 * l0) + l2) == &r and r == expect);
+
+        DV const b0 = a0, b2 = a2;
+        eval_in_place((l0 + l1) * (l2 * l0) + l2);
+        mkn::kul::abort_if_not(a0 == expect);
+        a0 = b0;
+
+        eval_into(a2, (l0 + l1) * (l2 * l0) + l2);
+        mkn::kul::abort_if_not(a2 == expect);
+        a2 = b2;
+
+        ThreadPool pool{3};
+        eval_into(a2, (l0 + l1) * (l2 * l0) + l2, par.on(pool).min_bytes_per_thread(1 << 10));
+        mkn::kul::abort_if_not(a2 == expect);
+        a2 = b2;
+
+        eval_into(r, l1); // nothing recorded
+        mkn::kul::abort_if_not(r == a1);
+        eval_in_place(l1);
+        mkn::kul::abort_if_not(a1 == DV(size, 2));
+    }
+}
+
+void functions()
+{
+    using DV = std::vector<double, mkn::kul::AlignedAllocator<double, Options::ALIGN()>>;
+    for (std::size_t const size : {std::size_t{1}, std::size_t{13}, std::size_t{100}})
+    {
+        DV a0(size), a1(size), a2(size, 2);
+        for (std::size_t i = 0; i < size; ++i)
+            a0[i] = i % 5, a1[i] = i % 3;
+        auto [l0, l1, l2] = lazy(a0, a1, a2);
+
+        auto const check = [&](auto const& r, auto const& fn) {
+            for (std::size_t i = 0; i < size; ++i)
+                mkn::kul::abort_if_not(std::abs(r[i] - fn(a0[i], a1[i], a2[i])) < 1e-12);
+        };
+        using std::abs, std::exp, std::sqrt;
+
+        check(eval(sqrt(l0 * l0 + l1 * l1)), [](auto x, auto y, auto) {
+            return sqrt(x * x + y * y);
+        });
+        check(eval(l2 + sqrt(l0)), [](auto x, auto, auto z) { return z + sqrt(x); });
+        check(eval(l2 * sqrt(l0 * l1)), [](auto x, auto y, auto z) { return z * sqrt(x * y); });
+        check(eval(abs(l1 - l0) * 2.0), [](auto x, auto y, auto) { return abs(y - x) * 2; });
+        check(eval(-l0 + l1), [](auto x, auto y, auto) { return y - x; });
+        check(eval(l2 - neg(l1)), [](auto, auto y, auto z) { return z + y; });
+        check(eval(exp(l1 - l2)), [](auto, auto y, auto z) { return exp(y - z); });
+        check(eval(min(l0, l1) + max(l1, l2)), [](auto x, auto y, auto z) {
+            return std::min(x, y) + std::max(y, z);
+        });
+        check(eval(max(1.0, l0 - l1)), [](auto x, auto y, auto) { return std::max(1., x - y); });
+        check(eval(clamp(l0 - l1, -1.0, 1.0)), [](auto x, auto y, auto) {
+            return std::clamp(x - y, -1., 1.);
+        });
+        check(eval(clamp(l0, l1, l2)), [](auto x, auto y, auto z) { return std::clamp(x, y, z); });
+    }
+
+    { // one pass, unary nodes on the result
+        DV a0(100, 3), a1(100, 4);
+        auto [l0, l1] = lazy(a0, a1);
+        auto lz       = sqrt(l0 * l0 + l1 * l1);
+        LazyEvaluator<decltype(lz)> evaluator{lz};
+        evaluator.compile();
+        auto const fused = Options::FMA; // the second mul is a tmp without
+        mkn::kul::abort_if_not(evaluator.instrs.size() == (fused ? 3 : 4)
+                               and evaluator.slots == (fused ? 0 : 1));
+        mkn::kul::abort_if_not(evaluator.instrs.back().code == LazyCode::SQRT);
+    }
+}
+
+void reductions()
+{
+    using DV = std::vector<double, mkn::kul::AlignedAllocator<double, Options::ALIGN()>>;
+    ThreadPool pool{4};
+    auto const policy = par.on(pool).min_bytes_per_thread(1 << 12);
+
+    for (std::size_t const size : {std::size_t{1}, std::size_t{13}, std::size_t{100}, N})
+    {
+        DV a0(size), a1(size, 2), a2(size, 3);
+        for (std::size_t i = 0; i < size; ++i)
+            a0[i] = i % 7;
+        auto [l0, l1, l2] = lazy(a0, a1, a2);
+
+        auto const r        = eval(l0 * l1 - l2);
+        auto const s        = std::accumulate(r.begin(), r.end(), 0.);
+        auto const [lo, hi] = std::minmax_element(r.begin(), r.end());
+
+        mkn::kul::abort_if_not(sum(l0 * l1 - l2) == s);
+        mkn::kul::abort_if_not(sum(l0 * l1 - l2, policy) == s);
+        mkn::kul::abort_if_not(min(l0 * l1 - l2) == *lo and max(l0 * l1 - l2) == *hi);
+        mkn::kul::abort_if_not(min(l0 * l1 - l2, policy) == *lo);
+        mkn::kul::abort_if_not(max(abs(l2 - l0)) == 3);
+        mkn::kul::abort_if_not(sum(l1) == 2. * size);
+    }
+}
+
+#if defined(__unix__) || defined(__APPLE__)
+// n T ending where a PROT_NONE page starts, so reading past the end faults.
+// The start is aligned down to Options::ALIGN(), what is left between the end
+// and the page is less than one aligned vector, which no read can cross into
+template<typename T>
+struct GuardedAllocator
+{
+    using value_type = T;
+
+    GuardedAllocator() = default;
+    template<typename U>
+    GuardedAllocator(GuardedAllocator<U> const&) noexcept
+    {
+    }
+
+    T* allocate(std::size_t const n)
+    {
+        auto* const base = static_cast<std::byte*>(mmap(nullptr, mapped(n), PROT_READ | PROT_WRITE,
+                                                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        mkn::kul::abort_if_not(base != MAP_FAILED);
+        mkn::kul::abort_if_not(mprotect(base + mapped(n) - page(), page(), PROT_NONE) == 0);
+        return reinterpret_cast<T*>(base + offset(n));
+    }
+    void deallocate(T* const p, std::size_t const n) noexcept
+    {
+        munmap(reinterpret_cast<std::byte*>(p) - offset(n), mapped(n));
+    }
+
+    bool operator==(GuardedAllocator const&) const noexcept { return true; }
+
+private:
+    static std::size_t page() { return static_cast<std::size_t>(sysconf(_SC_PAGESIZE)); }
+    static std::size_t data(std::size_t const n) // whole pages before the guard
+    {
+        return (n * sizeof(T) + page() - 1) / page() * page();
+    }
+    static std::size_t mapped(std::size_t const n) { return data(n) + page(); }
+    static std::size_t offset(std::size_t const n)
+    {
+        return (data(n) - n * sizeof(T)) & ~std::size_t{Options::ALIGN() - 1u};
+    }
+};
+#else
+template<typename T>
+using GuardedAllocator = mkn::kul::AlignedAllocator<T, Options::ALIGN()>;
+#endif
+
+// every size around the block and vector widths, inputs of exactly size that
+// end at a guard page, into a longer dst - nothing past size is read or written
+void bounds()
+{
+    using DV = std::vector<double, GuardedAllocator<double>>;
+
+    auto constexpr W        = Options::N<double>();
+    std::size_t const block = LazyProgram<DV>::default_batch() * W;
+    double const sentinel   = -7;
+
+    for (std::size_t size = 1; size < block * 3 + W; ++size)
+    {
+        DV a0(size), a1(size, 2), a2(size, 3), dst(size + W * 2, sentinel);
+        for (std::size_t i = 0; i < size; ++i)
+            a0[i] = i;
+        auto [l0, l1, l2] = lazy(a0, a1, a2);
+
+        eval_into(dst, sqrt(l0 * l1 + l2) - 1.0);
+        for (std::size_t i = 0; i < size; ++i)
+            mkn::kul::abort_if_not(dst[i] == std::sqrt(i * 2. + 3) - 1);
+        for (std::size_t i = size; i < dst.size(); ++i)
+            mkn::kul::abort_if_not(dst[i] == sentinel);
+
+        LazyPlan plan{l0 / l1 + l2};
+        for (std::size_t const vectors : {0, 1, 3})
+        {
+            std::fill(dst.begin(), dst.end(), sentinel);
+            plan.block(vectors)(dst.data());
+            for (std::size_t i = 0; i < size; ++i)
+                mkn::kul::abort_if_not(dst[i] == i / 2. + 3);
+            for (std::size_t i = size; i < dst.size(); ++i)
+                mkn::kul::abort_if_not(dst[i] == sentinel);
+        }
+    }
+}
+
+// the tuned block is kept per shape, results do not depend on it
+void tune()
+{
+    using DV = std::vector<double, mkn::kul::AlignedAllocator<double, Options::ALIGN()>>;
+
+    std::size_t constexpr size = 1e5 + 3;
+    DV a0(size, 1), a1(size, 2), a2(size, 3), a3(size, 4), r(size);
+    auto& tuning = LazyTuning::global();
+    tuning.clear();
+    {
+        auto [l0, l1, l2, l3] = lazy(a0, a1, a2, a3);
+        LazyPlan plan{l0 * l1 + l2 / l3};
+        plan.tune(r)(r);
+        mkn::kul::abort_if_not(r == DV(size, 2.75));
+        mkn::kul::abort_if_not(plan.block() >= 1 and plan.block() <= 128);
+        mkn::kul::abort_if_not(!tuning.empty());
+
+        auto [m0, m1, m2, m3] = lazy(a3, a2, a1, a0);
+        mkn::kul::abort_if_not(LazyPlan{m0 * m1 + m2 / m3}.block() == plan.block());
+        mkn::kul::abort_if_not(LazyPlan{m0 * m1 - m2 / m3}.block()
+                               == LazyProgram<DV>::default_batch());
+
+        // tuned per policy and thread count, not shared with seq
+        auto const single = plan.block();
+        auto const two    = par.with(2);
+        mkn::kul::abort_if_not(LazyPlan{m0 * m1 + m2 / m3, two}.block()
+                               == LazyProgram<DV>::default_batch());
+        LazyPlan pplan{l0 * l1 + l2 / l3, two};
+        pplan.tune(r, two)(r, two);
+        mkn::kul::abort_if_not(r == DV(size, 2.75));
+        mkn::kul::abort_if_not(LazyPlan{m0 * m1 + m2 / m3, two}.block() == pplan.block());
+        mkn::kul::abort_if_not(LazyPlan{m0 * m1 + m2 / m3, par.with(3)}.block()
+                               == LazyProgram<DV>::default_batch());
+        mkn::kul::abort_if_not(LazyPlan{m0 * m1 + m2 / m3}.block() == single);
+    }
+    {
+        tuning.clear().enable();
+        auto [l0, l1, l2] = lazy(a0, a1, a2);
+        eval_into(r, l0 * l1 - l2);
+        mkn::kul::abort_if_not(r == DV(size, -1));
+        mkn::kul::abort_if_not(!tuning.empty());
+
+        tuning.clear();
+        eval_into(a0, l0 * l1 - l2); // in place, each timed run would read the last
+        mkn::kul::abort_if_not(a0 == DV(size, -1));
+        mkn::kul::abort_if_not(tuning.empty());
+        tuning.enable(false).clear();
+    }
+}
+
+void tails()
+{
+    using DV = std::vector<float, mkn::kul::AlignedAllocator<float, Options::ALIGN()>>;
+    for (std::size_t size = 1; size < 200; ++size)
+    {
+        DV a0(size), a1(size, 2), a2(size, 3);
+        for (std::size_t i = 0; i < size; ++i)
+            a0[i] = i;
+        auto [l0, l1, l2] = lazy(a0, a1, a2);
+        auto r            = eval(l0 * l1 + l2 / l1);
+        for (std::size_t i = 0; i < size; ++i)
+            mkn::kul::abort_if_not(r[i] == i * 2 + 1.5f);
+    }
+}
+
 int main()
 {
     std::cout << __FILE__ << std::endl;
@@ -116,4 +648,18 @@ int main()
     fma3();
     fn0();
     fn1();
+    integers<std::int32_t>();
+    integers<std::int64_t>();
+    contract();
+    cse();
+    broadcast();
+    parallel();
+    plan();
+    graphs();
+    into();
+    functions();
+    reductions();
+    bounds();
+    tune();
+    tails();
 };
@@ -0,0 +1,178 @@
+
+#include "mkn/kul/log.hpp"
+#include "mkn/kul/assert.hpp"
+
+#include "mkn/avx.hpp"
+#include "mkn/avx/math.hpp"
+
+#include <cmath>
+#include <cfenv>
+#include <random>
+#include <limits>
+#include <iostream>
+
+using namespace mkn::avx;
+
+// |got - want| in units in the last place of T at want
+template<typename T>
+double ulps(T const got, long double const want)
+{
+    if (std::isnan(want))
+        return std::isnan(got) ? 0 : std::numeric_limits<double>::infinity();
+    if (std::isinf(want) or got == want)
+        return got == want ? 0 : std::numeric_limits<double>::infinity();
+    auto const w   = static_cast<T>(want);
+    auto const ulp = std::nextafter(std::abs(w), std::numeric_limits<T>::infinity()) - std::abs(w);
+    return static_cast<double>(std::abs(static_cast<long double>(got) - want) / ulp);
+}
+
+// worst error of fn over xs (and ys), N lanes at a time
+template<typename T, typename Fn, typename Ref>
+double worst(std::vector<T> const& xs, std::vector<T> const& ys, Fn const& fn, Ref const& ref)
+{
+    auto constexpr N = Options::N<T>();
+    double max       = 0;
+    for (std::size_t i = 0; i + N <= xs.size(); i += N)
+    {
+        auto const got = fn(unaligned_load<T, N>(&xs[i]), unaligned_load<T, N>(&ys[i]));
+        auto const* lanes = reinterpret_cast<T const*>(&got());
+        for (std::size_t l = 0; l < N; ++l)
+        {
+            auto const err = ulps(lanes[l], ref(static_cast<long double>(xs[i + l]),
+                                                static_cast<long double>(ys[i + l])));
+            if (err > max)
+                max = err;
+        }
+    }
+    return max;
+}
+
+template<typename T>
+std::vector<T> uniform(T const lo, T const hi, std::size_t const n = 1 << 16)
+{
+    std::mt19937_64 gen{7};
+    std::uniform_real_distribution<T> dist{lo, hi};
+    std::vector<T> v(n);
+    for (auto& e : v)
+        e = dist(gen);
+    return v;
+}
+
+// x = 2^u, u uniform
+template<typename T>
+std::vector<T> log_uniform(T const lo, T const hi, std::size_t const n = 1 << 16)
+{
+    auto v = uniform<T>(std::log2(lo), std::log2(hi), n);
+    for (auto& e : v)
+        e = std::exp2(e);
+    return v;
+}
+
+template<typename T>
+void accuracy()
+{
+    bool constexpr D = std::is_same_v<T, double>;
+    bool constexpr F = Options::FMA or Options::N<T>() == 1; // see math.hpp
+    auto const ones  = std::vector<T>(1 << 16, 1);
+    auto const check = [&](auto const& name, double const bound, auto const& xs, auto const& ys,
+                           auto const& fn, auto const& ref) {
+        auto const err = worst<T>(xs, ys, fn, ref);
+        KOUT(NON) << (D ? "double " : "float  ") << name << " " << err << " ulp";
+        mkn::kul::abort_if_not(err <= bound);
+    };
+
+    check("sqrt ", .5, log_uniform<T>(1e-30, 1e30), ones, [](auto x, auto) { return sqrt(x); },
+          [](auto x, auto) { return std::sqrt(x); });
+    check("rsqrt", 1.5, log_uniform<T>(1e-30, 1e30), ones, [](auto x, auto) { return rsqrt(x); },
+          [](auto x, auto) { return 1 / std::sqrt(x); });
+    check("exp  ", F ? 1 : 1.5, uniform<T>(D ? -745 : -103, D ? 709 : 88), ones,
+          [](auto x, auto) { return exp(x); }, [](auto x, auto) { return std::exp(x); });
+    check("exp  ", F ? 1 : 1.5, uniform<T>(-1, 1), ones, [](auto x, auto) { return exp(x); },
+          [](auto x, auto) { return std::exp(x); });
+    check("log  ", 1, log_uniform<T>(std::numeric_limits<T>::denorm_min(),
+                                     std::numeric_limits<T>::max()),
+          ones, [](auto x, auto) { return log(x); }, [](auto x, auto) { return std::log(x); });
+    check("log  ", 1, uniform<T>(.5, 2), ones, [](auto x, auto) { return log(x); },
+          [](auto x, auto) { return std::log(x); });
+    check("sin  ", 2, uniform<T>(-4, 4), ones, [](auto x, auto) { return sin(x); },
+          [](auto x, auto) { return std::sin(x); });
+    check("sin  ", F or D ? 2 : 3, uniform<T>(D ? -1e6 : -8192, D ? 1e6 : 8192), ones,
+          [](auto x, auto) { return sin(x); }, [](auto x, auto) { return std::sin(x); });
+    check("cos  ", 2, uniform<T>(-4, 4), ones, [](auto x, auto) { return cos(x); },
+          [](auto x, auto) { return std::cos(x); });
+    check("cos  ", F or D ? 2 : 3, uniform<T>(D ? -1e6 : -8192, D ? 1e6 : 8192), ones,
+          [](auto x, auto) { return cos(x); }, [](auto x, auto) { return std::cos(x); });
+    // 1 + 2 |y log(x)|, |y log(x)| <= 4 log(10)
+    check("pow  ", 20, uniform<T>(.1, 10), uniform<T>(-4, 4),
+          [](auto x, auto y) { return pow(x, y); }, [](auto x, auto y) { return std::pow(x, y); });
+}
+
+template<typename T>
+void specials()
+{
+    auto constexpr N   = Options::N<T>();
+    auto constexpr inf = std::numeric_limits<T>::infinity();
+    auto constexpr nan = std::numeric_limits<T>::quiet_NaN();
+    auto const v       = [](T const t) { return Type<T, N>{Type_<T, N>::set_v(t)}; };
+
+    mkn::kul::abort_if_not(exp(v(inf))[0] == inf);
+    mkn::kul::abort_if_not(exp(v(-inf))[0] == 0);
+    mkn::kul::abort_if_not(exp(v(1e4))[0] == inf);
+    mkn::kul::abort_if_not(exp(v(0))[0] == 1);
+    mkn::kul::abort_if_not(std::isnan(exp(v(nan))[0]));
+
+    mkn::kul::abort_if_not(log(v(0))[0] == -inf);
+    mkn::kul::abort_if_not(log(v(inf))[0] == inf);
+    mkn::kul::abort_if_not(log(v(1))[0] == 0);
+    mkn::kul::abort_if_not(std::isnan(log(v(-1))[0]));
+    mkn::kul::abort_if_not(std::isnan(log(v(nan))[0]));
+
+    mkn::kul::abort_if_not(sin(v(0))[0] == 0);
+    mkn::kul::abort_if_not(cos(v(0))[0] == 1);
+    mkn::kul::abort_if_not(std::isnan(sin(v(inf))[0]));
+    mkn::kul::abort_if_not(pow(v(0), v(0))[0] == 1);
+    mkn::kul::abort_if_not(pow(v(2), v(10))[0] == 1024);
+}
+
+// span ops and ragged tails
+template<typename T>
+void spans()
+{
+    constexpr auto N = Span<T>::N;
+    for (std::size_t size = 1; size < N * 3; ++size)
+    {
+        Vector<T> v0(size), v1(size), r(size);
+        for (std::size_t i = 0; i < size; ++i)
+            v0[i] = (i + 1) * .25, v1[i] = (i % 3) * .5;
+
+        auto [a, b, c] = make_unknown_size_spans(r, v0, v1);
+        auto const near = [&](auto const& ref) {
+            for (std::size_t i = 0; i < size; ++i)
+                mkn::kul::abort_if_not(ulps(r[i], ref(v0[i], v1[i])) <= 4);
+        };
+
+        std::feclearexcept(FE_ALL_EXCEPT); // inputs are valid, so are the lanes past the tail
+        a.exp(b), near([](long double x, long double) { return std::exp(x); });
+        a.log(b), near([](long double x, long double) { return std::log(x); });
+        a.sqrt(b), near([](long double x, long double) { return std::sqrt(x); });
+        a.rsqrt(b), near([](long double x, long double) { return 1 / std::sqrt(x); });
+        a.sin(b), near([](long double x, long double) { return std::sin(x); });
+        a.cos(b), near([](long double x, long double) { return std::cos(x); });
+        a.pow(b, c), near([](long double x, long double y) { return std::pow(x, y); });
+        mkn::kul::abort_if_not(!std::fetestexcept(FE_INVALID | FE_DIVBYZERO));
+    }
+}
+
+int main() noexcept
+{
+    KOUT(NON) << __FILE__;
+
+    accuracy<float>();
+    accuracy<double>();
+    specials<float>();
+    specials<double>();
+    spans<float>();
+    spans<double>();
+
+    return 0;
+}
@@ -0,0 +1,139 @@
+
+#include "mkn/kul/log.hpp"
+#include "mkn/kul/assert.hpp"
+
+#include "mkn/avx.hpp"
+#include "mkn/avx/parallel.hpp"
+
+#include <iostream>
+#include <stdexcept>
+
+using namespace mkn::avx;
+
+void partitions()
+{
+    for (std::size_t const batch_bytes : {8, 16, 32, 64})
+        for (std::size_t const threads : {1, 3, 7, 64})
+            for (std::size_t const batches : {1, 5, 100, 1001})
+                for (std::size_t const mis : {0, 16, 32, 48})
+                {
+                    if (mis % batch_bytes)
+                        continue;
+
+                    auto const* addr = reinterpret_cast<char const*>(std::uintptr_t{4096} + mis);
+                    auto const p     = partition(batches, batch_bytes, threads, addr);
+
+                    mkn::kul::abort_if_not(p.threads() > 0 and p.threads() <= threads);
+                    mkn::kul::abort_if_not(p.ranges.front().first == 0);
+                    mkn::kul::abort_if_not(p.ranges.back().second == batches);
+                    for (std::size_t t = 1; t < p.threads(); ++t)
+                    {
+                        auto const boundary = p.ranges[t].first;
+                        mkn::kul::abort_if_not(boundary == p.ranges[t - 1].second);
+                        mkn::kul::abort_if_not((mis + boundary * batch_bytes) % cache_line == 0);
+                    }
+                }
+
+    // too little work to spread
+    mkn::kul::abort_if_not(partition(100, 32, 8, nullptr, 1 << 15).threads() == 1);
+}
+
+void pool()
+{
+    ThreadPool pool{4};
+    mkn::kul::abort_if_not(pool.size() == 4);
+
+    for (std::size_t const tasks : {1, 3, 4, 9})
+    {
+        std::vector<std::size_t> hits(tasks, 0);
+        for (std::size_t r = 0; r < 100; ++r)
+            pool.run(tasks, [&](std::size_t const t) { ++hits[t]; });
+        for (auto const& hit : hits)
+            mkn::kul::abort_if_not(hit == 100);
+    }
+
+    std::atomic<std::size_t> nested = 0;
+    pool.run(4, [&](std::size_t const) { pool.run(2, [&](std::size_t const) { ++nested; }); });
+    mkn::kul::abort_if_not(nested == 8);
+
+    // caller task, worker task, caller extra - the workers always finish
+    for (std::size_t const bad : {0, 2, 5})
+    {
+        std::atomic<std::size_t> ran = 0;
+        bool caught                  = false;
+        try
+        {
+            pool.run(6, [&](std::size_t const t) {
+                if (t == bad)
+                    throw std::runtime_error{"task"};
+                ++ran;
+            });
+        }
+        catch (std::runtime_error const&)
+        {
+            caught = true;
+        }
+        mkn::kul::abort_if_not(caught);
+        mkn::kul::abort_if_not(ran == (bad == 0 ? 3 : 5)); // 0 throws before 4 and 5
+
+        // still parallel afterwards
+        std::vector<std::thread::id> ids(4);
+        pool.run(4, [&](std::size_t const t) { ids[t] = std::this_thread::get_id(); });
+        mkn::kul::abort_if_not(ids[1] != ids[0]);
+    }
+}
+
+template<typename T>
+void spans()
+{
+    std::size_t constexpr SIZE = 1e6 + 3;
+    ThreadPool pool{4};
+    auto const policy = par.on(pool).min_bytes_per_thread(1 << 12);
+
+    Vector<T> v0(SIZE, 1), v1(SIZE, 2), v2(SIZE, 3), r(SIZE);
+    {
+        auto [a, b, c, d] = make_unknown_size_spans(r, v0, v1, v2);
+
+        Partition p;
+        a.add(b, c, policy.report_to(p));
+        mkn::kul::abort_if_not(p.threads() == 4 and p.batches == SIZE / Span<T>::N);
+        mkn::kul::abort_if_not(a == 3);
+
+        a.fma(b, c, d, policy);
+        mkn::kul::abort_if_not(a == 5);
+
+        a.mul(a, c, policy);
+        a.sub(a, d, policy);
+        a.div(a, b, policy);
+        mkn::kul::abort_if_not(a == 7);
+
+        a.add(b, c, seq);
+        mkn::kul::abort_if_not(a == 3);
+
+        a.template add<Store::STREAM>(b, c, policy); // fenced per worker
+        a.template mul<Store::STREAM>(a, c, policy);
+        a.template sub<Store::STREAM>(a, d, policy);
+        a.template div<Store::STREAM>(a, c, policy);
+        mkn::kul::abort_if_not(a == 1.5);
+        a.template add<Store::CACHE>(b, c, policy);
+        mkn::kul::abort_if_not(a == 3);
+    }
+    {
+        v0.resize(SIZE - 3), r.resize(SIZE - 3);
+        auto [a, b] = make_spans(r, v0);
+        a.add(a, b, policy);
+        mkn::kul::abort_if_not(a == 4);
+    }
+}
+
+int main() noexcept
+{
+    KOUT(NON) << __FILE__;
+
+    partitions();
+    pool();
+    spans<float>();
+    spans<double>();
+
+    return 0;
+}
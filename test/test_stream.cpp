@@ -0,0 +1,74 @@
+// alignment below the vector width, and a threshold small enough to test
+#define MKN_AVX_ALIGN_AS 16
+#define MKN_AVX_STREAM_BYTES 1024
+
+#include "mkn/kul/log.hpp"
+#include "mkn/kul/assert.hpp"
+
+#include "mkn/avx.hpp"
+
+#include <iostream>
+
+using namespace mkn::avx;
+
+// when a span would write with non-temporal stores
+template<typename T>
+struct Probe : Span<T>
+{
+    using Span<T>::Span;
+    using Span<T>::streams;
+};
+
+template<typename T>
+void streams()
+{
+    using Aligned                = std::vector<T, mkn::kul::AlignedAllocator<T, 64>>;
+    std::size_t constexpr W      = sizeof(typename Span<T>::AVX_t);
+    std::size_t constexpr N      = Span<T>::N;
+    std::size_t constexpr small  = N * 2;
+    std::size_t constexpr big    = MKN_AVX_STREAM_BYTES * 2 / sizeof(T);
+    std::size_t constexpr offset = 16 / sizeof(T); // aligned to ALIGN, not W
+    std::size_t constexpr size   = big + 64 / sizeof(T);
+
+    Aligned v0(size), v1(size), r0(size, 0), r1(size, 0);
+    for (std::size_t i = 0; i < v0.size(); ++i)
+        v0[i] = i % 13 + 2, v1[i] = i % 5 + 1;
+
+    mkn::kul::abort_if_not(Probe<T>{r0.data(), big}.template streams<Store::AUTO>());
+    mkn::kul::abort_if_not(!Probe<T>{r0.data(), small}.template streams<Store::AUTO>());
+    mkn::kul::abort_if_not(!Probe<T>{r0.data(), big}.template streams<Store::CACHE>());
+    mkn::kul::abort_if_not(Probe<T>{r0.data(), small}.template streams<Store::STREAM>());
+
+    T* const off = r0.data() + offset;
+    mkn::kul::abort_if_not(is_aligned_pointer(off));
+    mkn::kul::abort_if_not(Probe<T>{off, big}.template streams<Store::AUTO>() == (W <= 16));
+    mkn::kul::abort_if_not(Probe<T>{off, big}.template streams<Store::STREAM>() == (W <= 16));
+
+    { // streamed under AUTO, matching cached writes
+        auto [a, b, c, d] = make_unknown_size_spans(v0, v1, r0, r1);
+        c.add(a, b), d.template add<Store::CACHE>(a, b);
+        mkn::kul::abort_if_not(r0 == r1);
+        c.mul(a, b), d.template mul<Store::CACHE>(a, b);
+        mkn::kul::abort_if_not(r0 == r1);
+    }
+
+    { // offset, cached, where streaming would fault
+        auto e = make_unknown_size_span(r1, offset, big);
+        e.copy(v0);
+        e.template copy<Store::STREAM>(v1);
+        for (std::size_t i = 0; i < big; ++i)
+            mkn::kul::abort_if_not(r1[i + offset] == v1[i]);
+    }
+}
+
+int main() noexcept
+{
+    std::cout << __FILE__ << std::endl;
+
+    streams<float>();
+    streams<double>();
+    streams<std::uint8_t>();
+    streams<std::int32_t>();
+
+    return 0;
+}